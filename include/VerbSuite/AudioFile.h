@@ -0,0 +1,111 @@
+#pragma once
+
+#include "VerbSuite/MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace verbsuite {
+
+enum class SampleFormat : std::uint8_t {
+    Int16,
+    Int24,
+    Int32,
+    Float32
+};
+
+[[nodiscard]] std::size_t bytesPerSample(SampleFormat format) noexcept;
+[[nodiscard]] const char* sampleFormatName(SampleFormat format) noexcept;
+
+// Streaming WAV writer: planar float in, interleaved PCM or float32 out through
+// a kBufferBytes staging buffer, so the stream sees one large write per fill.
+// The header goes out first with placeholder sizes and a JUNK chunk reserving
+// room for an RF64 ds64 chunk; close() patches the sizes and promotes the file
+// to RF64 once the RIFF size passes 4 GB. Integer output is clipped to
+// [-1, 1] and rounded half away from zero.
+class AudioFileWriter {
+public:
+    static constexpr std::size_t kBufferBytes = 1 << 20;
+
+    // Throws std::runtime_error when the file can't be created and
+    // std::invalid_argument for a zero channel count or a bad sample rate.
+    AudioFileWriter(const std::string& path, int sampleRate, std::size_t channels, SampleFormat format);
+    // Closes the file if close() wasn't called, ignoring errors.
+    ~AudioFileWriter();
+
+    AudioFileWriter(const AudioFileWriter&) = delete;
+    AudioFileWriter& operator=(const AudioFileWriter&) = delete;
+
+    // Appends `frames` frames; channels[c] holds channel c. Throws
+    // std::runtime_error on write errors.
+    void write(const float* const* channels, std::size_t frames);
+
+    // Flushes, patches the header and closes. Throws std::runtime_error on
+    // write errors.
+    void close();
+
+    [[nodiscard]] std::size_t channels() const noexcept { return channels_; }
+    [[nodiscard]] SampleFormat format() const noexcept { return format_; }
+    [[nodiscard]] std::uint64_t frames() const noexcept { return frames_; }
+
+private:
+    void flush();
+
+    std::ofstream out_;
+    std::string path_;
+    std::size_t channels_ = 0;
+    SampleFormat format_ = SampleFormat::Float32;
+    std::size_t frameBytes_ = 0;
+    std::size_t dataSizeOffset_ = 0;
+    std::vector<unsigned char> buffer_;
+    std::size_t buffered_ = 0;
+    std::uint64_t frames_ = 0;
+};
+
+// Streaming WAV/RF64 reader: 16/24/32-bit PCM or float32, any channel count,
+// WAVE_FORMAT_EXTENSIBLE included. Streamed input is read in kBufferBytes
+// chunks; memory-mapped input decodes straight from the mapping.
+class AudioFileReader {
+public:
+    static constexpr std::size_t kBufferBytes = 1 << 20;
+
+    enum class Access : std::uint8_t {
+        Stream,
+        MemoryMap
+    };
+
+    // Throws std::runtime_error on I/O errors and unsupported encodings.
+    explicit AudioFileReader(const std::string& path, Access access = Access::Stream);
+
+    AudioFileReader(const AudioFileReader&) = delete;
+    AudioFileReader& operator=(const AudioFileReader&) = delete;
+
+    [[nodiscard]] int sampleRate() const noexcept { return sampleRate_; }
+    [[nodiscard]] std::size_t channels() const noexcept { return channels_; }
+    [[nodiscard]] SampleFormat format() const noexcept { return format_; }
+    [[nodiscard]] std::uint64_t frames() const noexcept { return frames_; }
+    [[nodiscard]] std::uint64_t framesLeft() const noexcept { return frames_ - position_; }
+
+    // Decodes up to maxFrames into channels[0..channels()-1]; returns the
+    // frames read, 0 at the end of the data. Throws std::runtime_error when the
+    // file ends early.
+    std::size_t read(float* const* channels, std::size_t maxFrames);
+
+private:
+    std::ifstream in_;
+    std::optional<MappedFile> map_;
+    std::vector<unsigned char> buffer_;
+    int sampleRate_ = 0;
+    std::size_t channels_ = 0;
+    SampleFormat format_ = SampleFormat::Int16;
+    std::size_t frameBytes_ = 0;
+    std::uint64_t dataOffset_ = 0;
+    std::uint64_t frames_ = 0;
+    std::uint64_t position_ = 0;
+};
+
+} // namespace verbsuite
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace verbsuite {
+
+// One band's IR as handed to a band convolver. zeroIndex folds the causality
+// shift of the direct path (taps before it collapse onto delay 0) and gain
+// rescales the full IR to the level of the strided direct-form sum.
+struct ConvolverBandIR {
+    const float* data = nullptr;
+    std::size_t size = 0;
+    std::size_t zeroIndex = 0;
+    float gain = 1.0f;
+};
+
+// Common interface of the FFT convolution backends: one input convolved against
+// the three band IRs, fed a sample at a time from the engine's main loop.
+class BandConvolver {
+public:
+    static constexpr std::size_t kBands = 3;
+
+    virtual ~BandConvolver() = default;
+
+    [[nodiscard]] virtual std::size_t latencySamples() const noexcept = 0;
+
+    // True when no IR swap is in flight and setIRs() will be accepted.
+    [[nodiscard]] virtual bool readyForIRs() const noexcept = 0;
+
+    // Stages new IRs and starts a spread-out transform that ends in a crossfade.
+    // The data is copied, so the caller may overwrite its buffers straight away.
+    virtual void setIRs(const std::array<ConvolverBandIR, kBands>& bands) = 0;
+
+    // Transforms the IRs in one go and makes them active without a crossfade;
+    // used when (re)starting the engine.
+    virtual void loadIRs(const std::array<ConvolverBandIR, kBands>& bands) = 0;
+
+    virtual void reset() = 0;
+
+    // Pushes one input sample and writes the three band outputs.
+    virtual void process(float input, float* bandOut) = 0;
+
+protected:
+    // Writes the zero-folded, gain-scaled IR into dst (capacity floats, zero
+    // padded) and returns the number of meaningful taps.
+    static std::size_t foldBandIR(const ConvolverBandIR& band, float* dst, std::size_t capacity);
+};
+
+} // namespace verbsuite
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "VerbSuite/WeirdControls.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// Build with VERBSUITE_BLOCK_PROFILER=1 (CMake option of the same name) to have
+// WeirdConvolutionReverb::processBlock() time every block and push a record to
+// its attached BlockProfiler. Off by default, so the engine carries no
+// profiling code unless asked for.
+#ifndef VERBSUITE_BLOCK_PROFILER
+#define VERBSUITE_BLOCK_PROFILER 0
+#endif
+
+namespace verbsuite {
+
+// Flags in BlockRecord::events. StaleBand and Reversal also tag the LivingIRSet
+// that LivingIRSynth produced, and carry over to the block that installs it.
+enum class BlockEvent : std::uint8_t {
+    IRUpdate = 0x1,  // The block hit an IR update point.
+    StaleBand = 0x2, // Digital Failure left one band a copy of mid.
+    Reversal = 0x4   // The new IRs moved zeroIndex and reversed their early taps.
+};
+
+[[nodiscard]] constexpr std::uint8_t blockEventBit(BlockEvent event) noexcept {
+    return static_cast<std::uint8_t>(event);
+}
+
+[[nodiscard]] constexpr bool hasBlockEvent(std::uint8_t events, BlockEvent event) noexcept {
+    return (events & blockEventBit(event)) != 0;
+}
+
+// One processBlock() call.
+struct BlockRecord {
+    std::uint64_t cycles = 0;
+    std::uint32_t samples = 0;
+    WeirdMode mode = WeirdMode::LivingSignal;
+    std::uint8_t events = 0;
+    // Control stability for the block, before CV.
+    float stability = 0.0f;
+};
+
+// Timestamp counter: the TSC on x86, the virtual counter on AArch64, steady
+// clock nanoseconds elsewhere. Ticks at cycleCounterHz().
+[[nodiscard]] inline std::uint64_t readCycleCounter() noexcept {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    return __rdtsc();
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+    std::uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Not realtime-safe: the first call calibrates readCycleCounter() against the
+// steady clock, which takes about 50 ms.
+[[nodiscard]] double cycleCounterHz();
+
+// Block durations in log-spaced buckets: eight linear steps per octave, so any
+// bucket is within 12.5% of the values it holds. Plain counters, meant to be
+// filled from BlockProfiler::drain() off the audio thread.
+class BlockHistogram {
+public:
+    static constexpr std::size_t kSubBuckets = 8;
+    static constexpr std::size_t kBuckets = (64 - 2) * kSubBuckets;
+
+    void add(std::uint64_t cycles) noexcept;
+    void merge(const BlockHistogram& other) noexcept;
+    void clear() noexcept;
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+    [[nodiscard]] std::uint64_t max() const noexcept { return max_; }
+    [[nodiscard]] double mean() const noexcept;
+    // Upper edge of the bucket holding quantile q (0..1); exact for q = 1.
+    [[nodiscard]] std::uint64_t quantile(double q) const noexcept;
+    // Blocks that took longer than `cycles`, to bucket resolution.
+    [[nodiscard]] std::uint64_t countAbove(std::uint64_t cycles) const noexcept;
+
+    [[nodiscard]] std::uint64_t bucketCount(std::size_t bucket) const noexcept { return buckets_[bucket]; }
+    [[nodiscard]] static std::size_t bucketFor(std::uint64_t cycles) noexcept;
+    [[nodiscard]] static std::uint64_t bucketLowerEdge(std::size_t bucket) noexcept;
+    [[nodiscard]] static std::uint64_t bucketUpperEdge(std::size_t bucket) noexcept;
+
+private:
+    std::array<std::uint64_t, kBuckets> buckets_ {};
+    std::uint64_t count_ = 0;
+    std::uint64_t max_ = 0;
+    long double sum_ = 0.0L;
+};
+
+// Single-producer, single-consumer ring of BlockRecords. The engine pushes from
+// the audio thread without blocking or allocating; when the reader falls behind,
+// new records are dropped and counted. Attach one profiler per engine.
+class BlockProfiler {
+public:
+    // Not realtime-safe. Capacity rounds up to a power of two.
+    explicit BlockProfiler(std::size_t capacity = 16384);
+
+    BlockProfiler(const BlockProfiler&) = delete;
+    BlockProfiler& operator=(const BlockProfiler&) = delete;
+
+    // Audio thread.
+    bool push(const BlockRecord& record) noexcept {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == records_.size()) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        records_[head & mask_] = record;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Reader thread. Hands every queued record to `visit` in push order and
+    // returns how many there were.
+    template <typename Visitor>
+    std::size_t drain(Visitor&& visit) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        for (std::size_t i = tail; i != head; ++i) {
+            visit(static_cast<const BlockRecord&>(records_[i & mask_]));
+        }
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return records_.size(); }
+    [[nodiscard]] std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<BlockRecord> records_;
+    std::size_t mask_ = 0;
+    // Monotonic counts; the slot is the count masked by capacity.
+    alignas(64) std::atomic<std::size_t> head_ { 0 };
+    alignas(64) std::atomic<std::size_t> tail_ { 0 };
+    std::atomic<std::uint64_t> dropped_ { 0 };
+};
+
+} // namespace verbsuite
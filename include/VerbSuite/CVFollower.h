@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace verbsuite {
+
+enum class CVShape : std::uint8_t {
+    // The mono sidechain, clamped to [-1, 1].
+    Raw,
+    // Its attack/release envelope, sampled and held every holdPeriod samples.
+    Envelope
+};
+
+struct CVFollowerSettings {
+    CVShape shape = CVShape::Raw;
+    float attackSeconds = 0.006f;
+    float releaseSeconds = 0.048f;
+    std::size_t holdPeriod = 12;
+
+    [[nodiscard]] bool operator==(const CVFollowerSettings&) const = default;
+};
+
+// Turns a stereo sidechain into a stability CV. Buffers are sized by
+// prepare(), and the attack/release coefficients are only recomputed when the
+// settings change, so process() never allocates or calls exp. Besides the
+// audio-rate CV, each block also yields a decimated control-rate CV: one value
+// per controlInterval samples, from the start of the block.
+class CVFollower {
+public:
+    // Not realtime-safe.
+    void prepare(double sampleRate, std::size_t maxBlockSize, std::size_t controlInterval = 1);
+    void reset() noexcept;
+
+    // Realtime-safe; cheap when nothing changed.
+    void setSettings(const CVFollowerSettings& settings) noexcept;
+    [[nodiscard]] const CVFollowerSettings& settings() const noexcept { return settings_; }
+
+    // Realtime-safe for numSamples up to the prepared block size. `right` may
+    // equal `left` for a mono sidechain. Returns the audio-rate CV; the spans
+    // stay valid until the next call.
+    std::span<const float> process(const float* left, const float* right, std::size_t numSamples) noexcept;
+    // Control-rate CV of the last block: ceil(numSamples / controlInterval)
+    // values, value k being the CV at sample k * controlInterval.
+    [[nodiscard]] std::span<const float> controlRate() const noexcept { return { control_.data(), controlCount_ }; }
+    [[nodiscard]] std::size_t controlInterval() const noexcept { return controlInterval_; }
+    // Largest |CV| in the last block, for metering.
+    [[nodiscard]] float peak() const noexcept { return peak_; }
+
+private:
+    void updateCoefficients() noexcept;
+    [[nodiscard]] float envelopeStep(float envelope, float left, float right) const noexcept {
+        const float target = std::abs(std::clamp(0.5f * (left + right), -1.0f, 1.0f));
+        return envelope + (target > envelope ? attackAlpha_ : releaseAlpha_) * (target - envelope);
+    }
+
+    double sampleRate_ = 48000.0;
+    std::size_t controlInterval_ = 1;
+    CVFollowerSettings settings_;
+    float attackAlpha_ = 1.0f;
+    float releaseAlpha_ = 1.0f;
+
+    float envelope_ = 0.0f;
+    float held_ = 0.0f;
+    // Samples until the next hold point; 0 holds on the next sample.
+    std::size_t holdLeft_ = 0;
+
+    std::vector<float> output_;
+    std::vector<float> control_;
+    std::size_t controlCount_ = 0;
+    float peak_ = 0.0f;
+};
+
+} // namespace verbsuite
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "VerbSuite/WeirdControls.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace verbsuite {
+
+// Everything a host changes on an engine while it runs.
+struct EngineSettings {
+    WeirdMode mode = WeirdMode::LivingSignal;
+    WeirdControls controls;
+
+    [[nodiscard]] bool operator==(const EngineSettings&) const = default;
+};
+
+// What a ControlEvent changes: the mode, or one WeirdControls field.
+enum class ControlTarget : std::uint8_t {
+    Mode,
+    Memory,
+    Coherence,
+    Entropy,
+    Resistance,
+    Stability,
+    BreathRateHz,
+    BreathDepth,
+    BreathBeats,
+    Bpm,
+    TempoSync,
+    WildIrBank,
+    Freeze,
+    Wet,
+    Dry
+};
+
+// A change `offset` samples into the block it is queued for. The value is the
+// mode index for Mode and on above 0.5 for the switches.
+struct ControlEvent {
+    std::uint32_t offset = 0;
+    ControlTarget target = ControlTarget::Stability;
+    float value = 0.0f;
+};
+
+// Hands EngineSettings from one control thread (a UI, a host's parameter
+// thread, or the audio thread itself) to the engine's audio thread. Both sides
+// are wait-free: the writer never waits for the engine to pick settings up,
+// and the engine only ever sees the newest complete settings.
+class ControlBlock {
+public:
+    // Writer thread only.
+    void publish(const EngineSettings& settings) noexcept;
+    // Audio thread only. Copies the newest settings into `settings` and returns
+    // true when any were published since the last call.
+    bool consume(EngineSettings& settings) noexcept;
+    // Number of publish() calls so far; any thread.
+    [[nodiscard]] std::uint64_t version() const noexcept { return version_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr std::uint8_t kIndexMask = 0x3u;
+    static constexpr std::uint8_t kFresh = 0x4u;
+
+    // Triple buffer: the writer owns backIndex_, the engine frontIndex_, and
+    // middle_ holds the shared slot index plus the kFresh flag.
+    std::array<EngineSettings, 3> slots_;
+    std::uint8_t backIndex_ = 0;
+    std::uint8_t frontIndex_ = 1;
+    std::atomic<std::uint8_t> middle_ { 2 };
+    std::atomic<std::uint64_t> version_ { 0 };
+};
+
+// Linear ramp from the current value to a target over a given number of
+// samples. A new target restarts the ramp from wherever it is.
+class LinearRamp {
+public:
+    void snap(float value) noexcept {
+        current_ = value;
+        target_ = value;
+        samplesLeft_ = 0;
+    }
+
+    // Ramps to `target` over `samples` samples; 0 jumps there.
+    void setTarget(float target, std::size_t samples) noexcept {
+        if (target == target_) {
+            return;
+        }
+        if (samples == 0) {
+            snap(target);
+            return;
+        }
+        target_ = target;
+        step_ = (target - current_) / static_cast<float>(samples);
+        samplesLeft_ = samples;
+    }
+
+    // The value for the next sample.
+    float next() noexcept {
+        if (samplesLeft_ == 0) {
+            return current_;
+        }
+        current_ = --samplesLeft_ == 0 ? target_ : current_ + step_;
+        return current_;
+    }
+
+    // The value `samples` samples on.
+    float skip(std::size_t samples) noexcept {
+        if (samples >= samplesLeft_) {
+            snap(target_);
+        } else {
+            samplesLeft_ -= samples;
+            current_ += step_ * static_cast<float>(samples);
+        }
+        return current_;
+    }
+
+    [[nodiscard]] bool ramping() const noexcept { return samplesLeft_ > 0; }
+    [[nodiscard]] float current() const noexcept { return current_; }
+    [[nodiscard]] float target() const noexcept { return target_; }
+
+private:
+    float current_ = 0.0f;
+    float target_ = 0.0f;
+    float step_ = 0.0f;
+    std::size_t samplesLeft_ = 0;
+};
+
+} // namespace verbsuite
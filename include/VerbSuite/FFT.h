@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace verbsuite {
+
+// Power-of-two real FFT in split (re/im) format. Forward yields size/2 + 1 bins;
+// inverse takes the same layout and is scaled by 1/size, so a round trip is
+// identity. All tables are built in the constructor; transforms never allocate.
+class RealFFT {
+public:
+    explicit RealFFT(std::size_t size);
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::size_t numBins() const noexcept { return size_ / 2 + 1; }
+
+    void forward(const float* input, float* re, float* im);
+    void inverse(const float* re, const float* im, float* output);
+
+private:
+    void complexTransform(float* re, float* im, bool inverse) const;
+
+    std::size_t size_;
+    std::size_t half_;
+    std::vector<std::size_t> bitReverse_;
+    std::vector<float> twiddleRe_;
+    std::vector<float> twiddleIm_;
+    std::vector<float> packRe_;
+    std::vector<float> packIm_;
+    std::vector<float> workRe_;
+    std::vector<float> workIm_;
+};
+
+} // namespace verbsuite
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+// Build with VERBSUITE_FAST_MATH=1 (CMake option of the same name) to route the
+// DSP core's per-sample tanh/sin through the approximations below instead of
+// libm. Off by default so renders stay bit-identical to the exact build.
+#ifndef VERBSUITE_FAST_MATH
+#define VERBSUITE_FAST_MATH 0
+#endif
+
+namespace verbsuite {
+
+// Odd 13/6 rational minimax fit, clamped where it reaches +-1 in float. Max
+// absolute error against tanh is below 4e-7. Branch-free, so loops over it
+// vectorize.
+[[nodiscard]] inline float fastTanh(float x) noexcept {
+    x = std::clamp(x, -7.90531110763549805f, 7.90531110763549805f);
+    const float x2 = x * x;
+    float p = -2.76076847742355e-16f;
+    p = p * x2 + 2.00018790482477e-13f;
+    p = p * x2 - 8.60467152213735e-11f;
+    p = p * x2 + 5.12229709037114e-08f;
+    p = p * x2 + 1.48572235717979e-05f;
+    p = p * x2 + 6.37261928875436e-04f;
+    p = p * x2 + 4.89352455891786e-03f;
+    float q = 1.19825839466702e-06f;
+    q = q * x2 + 1.18534705686654e-04f;
+    q = q * x2 + 2.26843463243900e-03f;
+    q = q * x2 + 4.89352518554385e-03f;
+    return x * p / q;
+}
+
+// Reduces to a quarter turn and evaluates the degree-11 Taylor polynomial of
+// sin(2 pi t). Max absolute error is below 1e-6 for |x| < 2 pi and grows only
+// with the float resolution of x itself. Branch-free.
+[[nodiscard]] inline float fastSin(float x) noexcept {
+    // 1.5 * 2^23: adding and subtracting it rounds to the nearest integer
+    // without a libm call.
+    constexpr float kRound = 12582912.0f;
+    float t = x * 0.159154943091895336f;
+    t -= (t + kRound) - kRound;
+    t = std::fabs(t) > 0.25f ? std::copysign(0.5f, t) - t : t;
+    const float t2 = t * t;
+    float p = -15.0946425768101f;
+    p = p * t2 + 42.0587502328296f;
+    p = p * t2 - 76.7058597530613f;
+    p = p * t2 + 81.6052492760750f;
+    p = p * t2 - 41.3417022403997f;
+    p = p * t2 + 6.28318530717958648f;
+    return t * p;
+}
+
+// What the per-sample paths call: libm, or the approximations when built fast.
+[[nodiscard]] inline float dspTanh(float x) noexcept {
+#if VERBSUITE_FAST_MATH
+    return fastTanh(x);
+#else
+    return std::tanh(x);
+#endif
+}
+
+[[nodiscard]] inline float dspSin(float x) noexcept {
+#if VERBSUITE_FAST_MATH
+    return fastSin(x);
+#else
+    return std::sin(x);
+#endif
+}
+
+} // namespace verbsuite
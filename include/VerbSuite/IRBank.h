@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace verbsuite {
+
+// The source IRs the living IRs morph between: kCoreCount core entries followed
+// by kWildCount wild ones. Immutable once built; every engine using a bank
+// shares one instance. The built-in bank is generated per sample rate so
+// decays, tones and pulse rates keep their timing in seconds; file banks keep
+// each IR's own rate and are memory-mapped read-only.
+//
+// File format (little-endian):
+//   header  "VSIRBANK", u32 version (1), u32 IR count
+//   table   per IR: f64 sample rate, u64 byte offset of its payload, u64 length
+//   payload float32 samples, each IR starting on a kPayloadAlignment boundary
+class IRBank {
+public:
+    static constexpr std::size_t kCoreCount = 8;
+    static constexpr std::size_t kWildCount = 8;
+    static constexpr std::size_t kPayloadAlignment = 64;
+    // Rate the built-in bank's lengths and sample-index patterns were tuned at.
+    static constexpr double kReferenceRate = 48000.0;
+
+    // Generates the built-in bank at `sampleRate`.
+    explicit IRBank(double sampleRate);
+
+    IRBank(const IRBank&) = delete;
+    IRBank& operator=(const IRBank&) = delete;
+
+    // Process-wide built-in bank for `sampleRate`, built on first use and kept
+    // for the life of the process. Thread-safe; not realtime-safe.
+    [[nodiscard]] static std::shared_ptr<const IRBank> forSampleRate(double sampleRate);
+
+    // Maps a bank file read-only; its pages are shared with every other process
+    // mapping the same file. Throws std::runtime_error on I/O or format errors.
+    [[nodiscard]] static std::shared_ptr<const IRBank> load(const std::string& path);
+
+    // `bank` itself when every IR already runs at `sampleRate`, otherwise a
+    // copy with the off-rate IRs linearly resampled.
+    [[nodiscard]] static std::shared_ptr<const IRBank> atSampleRate(std::shared_ptr<const IRBank> bank, double sampleRate);
+
+    // Throws std::runtime_error when the file can't be written.
+    void save(const std::string& path) const;
+
+    [[nodiscard]] const std::vector<std::span<const float>>& irs() const noexcept { return irs_; }
+    [[nodiscard]] double irSampleRate(std::size_t index) const noexcept { return rates_[index]; }
+
+private:
+    IRBank() = default;
+
+    void adopt(std::vector<float> ir, double sampleRate);
+
+    static std::vector<float> generateIR(std::size_t length, float decaySeconds, float diffusion, float tone, double sampleRate);
+    static std::vector<float> generateMorseIR(std::size_t length, float density, double sampleRate);
+    static std::vector<float> generateBodyIR(std::size_t length, float pulseHz, double sampleRate);
+
+    // Owned IRs (built-in and resampled banks) or the file mapping the spans
+    // point into.
+    std::vector<std::vector<float>> owned_;
+    std::shared_ptr<const void> storage_;
+    std::vector<std::span<const float>> irs_;
+    std::vector<double> rates_;
+};
+
+} // namespace verbsuite
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace verbsuite {
+
+class IRSynthesisWorker;
+
+// A fixed set of threads that run the IR rebuilds of every attached
+// IRSynthesisWorker, so N engines share a few cores instead of each owning a
+// thread. Each worker's pending job carries the deadline of the engine's next
+// update point. A pool thread takes the earliest-deadline job among the workers
+// it is home to, and steals the earliest one elsewhere when its own are idle.
+// Submitting from the audio thread stays lock-free; only attach and detach take
+// the registry lock.
+class IRSynthesisPool {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        std::uint64_t jobs = 0;
+        // Jobs finished after their deadline; the engine kept its previous IRs
+        // for at least one more update.
+        std::uint64_t late = 0;
+        // Jobs run by a thread other than the worker's home thread.
+        std::uint64_t stolen = 0;
+        double busySeconds = 0.0;
+    };
+
+    // Not realtime-safe. `threads` == 0 picks one less than the core count.
+    explicit IRSynthesisPool(std::size_t threads = 0);
+    ~IRSynthesisPool();
+
+    IRSynthesisPool(const IRSynthesisPool&) = delete;
+    IRSynthesisPool& operator=(const IRSynthesisPool&) = delete;
+
+    // Process-wide pool, started on first use and stopped at exit. Thread-safe;
+    // not realtime-safe.
+    [[nodiscard]] static IRSynthesisPool& shared();
+
+    [[nodiscard]] std::size_t threadCount() const noexcept { return threads_.size(); }
+    [[nodiscard]] Stats stats() const noexcept;
+
+private:
+    friend class IRSynthesisWorker;
+
+    // Not realtime-safe. detach() returns once no pool thread is running the
+    // worker's job.
+    void attach(IRSynthesisWorker* worker);
+    void detach(IRSynthesisWorker* worker);
+    // Audio thread: a worker has a new pending job.
+    void wake() noexcept;
+
+    void run(std::size_t index);
+    // Claims the job to run next for thread `index`, or returns null.
+    [[nodiscard]] IRSynthesisWorker* claim(std::size_t index, bool& stolen);
+
+    std::mutex registryMutex_;
+    // Slot i is home to thread i % threadCount(); freed slots are reused.
+    std::vector<IRSynthesisWorker*> workers_;
+
+    std::atomic<std::uint32_t> signal_ { 0 };
+    std::atomic<bool> stopping_ { false };
+
+    std::atomic<std::uint64_t> jobs_ { 0 };
+    std::atomic<std::uint64_t> late_ { 0 };
+    std::atomic<std::uint64_t> stolen_ { 0 };
+    std::atomic<std::uint64_t> busyNanoseconds_ { 0 };
+
+    std::vector<std::thread> threads_;
+};
+
+} // namespace verbsuite
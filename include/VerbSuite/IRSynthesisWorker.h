@@ -0,0 +1,84 @@
+#pragma once
+
+#include "VerbSuite/IRSynthesisPool.h"
+#include "VerbSuite/LivingIRSynth.h"
+#include "VerbSuite/Random.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace verbsuite {
+
+// Runs LivingIRSynth off the audio thread: on a dedicated thread, or on the
+// threads of an IRSynthesisPool shared with other workers. The audio thread
+// hands over a snapshot through a single request slot and picks finished IR
+// sets up through a lock-free triple buffer; neither side ever blocks on the
+// other.
+class IRSynthesisWorker {
+public:
+    // A null `pool` starts a dedicated thread.
+    IRSynthesisWorker(const std::vector<std::span<const float>>& bank, std::size_t irCapacity, std::size_t feedbackSize, const RandomStream& rng, IRSynthesisPool* pool = nullptr);
+    ~IRSynthesisWorker();
+
+    IRSynthesisWorker(const IRSynthesisWorker&) = delete;
+    IRSynthesisWorker& operator=(const IRSynthesisWorker&) = delete;
+
+    // Audio thread. Queues a rebuild due by `deadline`, which orders the jobs
+    // of a pool. A previous request no thread has picked up yet is replaced;
+    // if one is still running, this request is dropped and the next update
+    // point retries.
+    bool submit(const LivingIRSnapshot& state, const FeedbackView& feedback, IRSynthesisPool::Clock::time_point deadline = {});
+
+    // Audio thread. Swaps the newest finished set into `active`; returns false
+    // (leaving `active` untouched) when the worker has not delivered anything new.
+    bool collect(LivingIRSet& active);
+
+    // Non-realtime. Waits for an in-flight job, discards undelivered results and
+    // restarts the worker's random draws from `rng`.
+    void reset(const RandomStream& rng);
+
+private:
+    friend class IRSynthesisPool;
+
+    void run();
+    // Whoever moved the request from kPending to kRunning: synthesizes,
+    // publishes and hands the slot back.
+    void runClaimed();
+    [[nodiscard]] bool tryClaim() noexcept;
+    [[nodiscard]] static bool learnsFromFeedback(WeirdMode mode);
+
+    static constexpr std::uint32_t kIdle = 0;
+    static constexpr std::uint32_t kPending = 1;
+    static constexpr std::uint32_t kStopping = 2;
+    static constexpr std::uint32_t kRunning = 3;
+    static constexpr std::uint8_t kIndexMask = 0x3u;
+    static constexpr std::uint8_t kFresh = 0x4u;
+
+    LivingIRSynth synth_;
+    RandomStream rng_;
+
+    // Request slot: kIdle = owned by the audio thread, kPending = waiting for a
+    // thread (the audio thread may still take it back), kRunning = owned by the
+    // thread that claimed it.
+    std::atomic<std::uint32_t> requestState_ { kIdle };
+    std::atomic<IRSynthesisPool::Clock::rep> deadline_ { 0 };
+    LivingIRSnapshot request_;
+    std::vector<float> requestFeedback_;
+    FeedbackView requestFeedbackView_;
+
+    // Triple buffer: worker owns backIndex_, audio thread owns frontIndex_,
+    // middle_ holds the shared slot index plus the kFresh flag.
+    std::array<LivingIRSet, 3> slots_;
+    std::uint8_t backIndex_ = 0;
+    std::uint8_t frontIndex_ = 1;
+    std::atomic<std::uint8_t> middle_ { 2 };
+
+    IRSynthesisPool* pool_ = nullptr;
+    std::thread thread_;
+};
+
+} // namespace verbsuite
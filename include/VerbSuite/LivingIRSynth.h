@@ -0,0 +1,166 @@
+#pragma once
+
+#include "VerbSuite/Random.h"
+#include "VerbSuite/WeirdControls.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace verbsuite {
+
+// Everything updateLivingIR() reads from the engine, captured at the update point
+// so the same synthesis can run inline or on another thread.
+struct LivingIRSnapshot {
+    WeirdMode mode = WeirdMode::LivingSignal;
+    WeirdControls controls;
+    double sampleRate = 48000.0;
+    float featureEnvelope = 0.0f;
+    float featureBrightness = 0.0f;
+    float dynamicStability = 0.5f;
+    std::size_t frameCounter = 0;
+};
+
+// Read-only view of the engine's feedback ring, used by the learning modes.
+struct FeedbackView {
+    const float* data = nullptr;
+    std::size_t size = 0;
+    std::size_t write = 0;
+};
+
+// One set of band IRs plus the causality offset that goes with it.
+struct LivingIRSet {
+    std::vector<float> low;
+    std::vector<float> mid;
+    std::vector<float> high;
+    std::size_t zeroIndex = 0;
+    // BlockEvent::StaleBand / Reversal bits for the synthesis that produced it.
+    std::uint8_t events = 0;
+
+    void prepare(std::size_t capacity);
+};
+
+// Preallocated scratch for living-IR regeneration. Every stage writes into these
+// (or ping-pongs with the output IRs), so once prepare() has reserved the
+// capacity no IR update touches the heap.
+struct IRWorkspace {
+    std::vector<float> baseA;
+    std::vector<float> baseB;
+    std::vector<float> scratch;
+    // Batched uniform draws for the per-grain and per-8-tap passes.
+    std::vector<float> uniforms;
+
+    void prepare(std::size_t capacity);
+    void release();
+};
+
+// Morph/stretch/modulate/misalign pipeline that turns a feature snapshot into a
+// fresh LivingIRSet. Holds no audio-thread state besides its workspace and the
+// job in progress, so one instance per thread is enough.
+//
+// The pipeline is a fixed schedule of passes over the taps. run() does them
+// all at once; begin()/step() do the same passes a slice at a time, with the
+// same results and the same draws from the stream they are given.
+class LivingIRSynth {
+public:
+    explicit LivingIRSynth(const std::vector<std::span<const float>>& bank);
+
+    // Upper bound of the elastic-time stretch, used to size the IR workspace.
+    static constexpr float kMaxBreathStretch = 2.6f;
+
+    [[nodiscard]] static std::size_t capacityFor(const std::vector<std::span<const float>>& bank);
+
+    // Points the synth at another bank; the caller keeps it alive.
+    void setBank(const std::vector<std::span<const float>>& bank) noexcept { bank_ = &bank; }
+    void prepare(std::size_t irCapacity);
+    // Frees the workspace; prepare() again before the next job. Cancels any
+    // job in progress.
+    void release();
+    void run(const LivingIRSnapshot& state, const FeedbackView& feedback, RandomStream& rng, LivingIRSet& out);
+
+    // Starts a job that writes into `out`, dropping any job in progress. `out`
+    // and the ring behind `feedback` must outlive the job; the learning pass
+    // reads the ring when it gets there, not at begin().
+    void begin(const LivingIRSnapshot& state, const FeedbackView& feedback, LivingIRSet& out);
+    // Runs passes until about `budget` taps have been processed; a pass's setup
+    // (including its draws) counts as free. Returns true once `out` is complete.
+    bool step(std::size_t budget, RandomStream& rng);
+    void cancel() noexcept { out_ = nullptr; }
+    [[nodiscard]] bool busy() const noexcept { return out_ != nullptr; }
+    // Taps the job has left, from the sizes begin() predicted.
+    [[nodiscard]] std::size_t remainingWork() const noexcept { return workTotal_ > workDone_ ? workTotal_ - workDone_ : 0; }
+
+    static void morphIR(std::span<const float> a, std::span<const float> b, float t, std::vector<float>& out);
+
+private:
+    enum class Pass : std::uint8_t {
+        MorphBaseA,
+        MorphBaseB,
+        MorphMid,
+        MorphLow,
+        MorphHigh,
+        Stretch,
+        Resample,
+        Grains,
+        Quantize,
+        Rotate,
+        Flip,
+        Causality,
+        Learn,
+        StaleBand
+    };
+    struct PassStep {
+        Pass pass;
+        std::uint8_t band; // 0 low, 1 mid, 2 high; ignored by whole-set passes.
+    };
+    static const std::array<PassStep, 24> kSchedule;
+
+    [[nodiscard]] std::vector<float>& band(std::uint8_t index) const noexcept;
+    [[nodiscard]] std::size_t predictWork() const;
+    void openPass(RandomStream& rng);
+    void runPass(std::size_t begin, std::size_t end);
+    void closePass(RandomStream& rng);
+
+    const std::vector<std::span<const float>>* bank_;
+    IRWorkspace workspace_;
+
+    // Job in progress; out_ is null when idle.
+    LivingIRSet* out_ = nullptr;
+    LivingIRSnapshot state_;
+    FeedbackView feedback_;
+    std::size_t schedulePos_ = 0;
+    bool passOpen_ = false;
+    std::size_t cursor_ = 0;
+    std::size_t passEnd_ = 0;
+    std::size_t workTotal_ = 0;
+    std::size_t workDone_ = 0;
+
+    // Per-job parameters, fixed by the snapshot at begin().
+    std::size_t bankStart_ = 0;
+    float indexA_ = 0.0f;
+    float indexB_ = 0.0f;
+    float morph_ = 0.0f;
+    float breathing_ = 1.0f;
+    float microSpeed_ = 1.0f;
+    std::size_t grainStep_ = 4;
+    float jitterRange_ = 0.0f;
+    float quantizeScale_ = 1.0f;
+    std::size_t quantizeHold_ = 1;
+    float drive_ = 1.0f;
+    bool misalign_ = false;
+    float cosRot_ = 1.0f;
+    float sinRot_ = 0.0f;
+    float flipChance_ = 0.0f;
+    float learnRate_ = 0.0f;
+
+    // The open pass: a morph's operands, or the band it works on.
+    std::span<const float> morphA_;
+    std::span<const float> morphB_;
+    float morphT_ = 0.0f;
+    std::vector<float>* target_ = nullptr;
+    std::size_t reverseSpan_ = 0;
+};
+
+} // namespace verbsuite
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace verbsuite {
+
+// Read-only view of a whole file: a shared mapping where the platform has one,
+// otherwise an aligned heap copy. Copies share the same view.
+class MappedFile {
+public:
+    // Throws std::runtime_error when the file can't be opened, is empty or
+    // can't be mapped.
+    explicit MappedFile(const std::string& path);
+
+    [[nodiscard]] const unsigned char* data() const noexcept { return data_; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    // Keeps the view alive; hand it to anything holding pointers into data().
+    [[nodiscard]] const std::shared_ptr<const void>& owner() const noexcept { return owner_; }
+
+    // Tells the kernel the view will be read front to back. A hint only.
+    void adviseSequential() const noexcept;
+
+private:
+    std::shared_ptr<const void> owner_;
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace verbsuite
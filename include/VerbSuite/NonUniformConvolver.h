@@ -0,0 +1,69 @@
+#pragma once
+
+#include "VerbSuite/BandConvolver.h"
+#include "VerbSuite/FFT.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace verbsuite {
+
+// Zero-latency non-uniformly partitioned convolution of one input against three
+// band IRs. The first headSize taps run in direct form; the rest of the IR is
+// covered by FFT segments whose partition size doubles (headSize/2, headSize,
+// 2*headSize, ... up to 1024). Every segment starts at least two partitions
+// into the IR, which leaves one partition of slack: a segment's FFT/MAC/IFFT
+// work is paced evenly over the samples that follow its block instead of
+// landing in the callback that completes it.
+class NonUniformConvolver final : public BandConvolver {
+public:
+    NonUniformConvolver(std::size_t headSize, std::size_t maxIRLength);
+    ~NonUniformConvolver() override;
+
+    [[nodiscard]] std::size_t latencySamples() const noexcept override { return 0; }
+    [[nodiscard]] bool readyForIRs() const noexcept override;
+
+    void setIRs(const std::array<ConvolverBandIR, kBands>& bands) override;
+    void loadIRs(const std::array<ConvolverBandIR, kBands>& bands) override;
+    void reset() override;
+    void process(float input, float* bandOut) override;
+
+private:
+    struct Segment;
+
+    void advanceTransform(std::size_t target);
+    void transformItem(std::size_t item);
+    void startBlock(Segment& segment);
+    void advanceBlock(Segment& segment, std::size_t target);
+    void finishSwitch();
+
+    std::size_t headSize_;
+    std::size_t maxIRLength_;
+
+    // Direct-form head: mirrored input history so the dot product never wraps.
+    std::vector<float> headHistory_;
+    std::size_t headWrite_ = 0;
+    std::array<std::vector<float>, 2> headTaps_;
+    std::size_t headActive_ = 0;
+    std::size_t headCrossfadePos_ = 0;
+    bool headCrossfading_ = false;
+
+    std::vector<std::unique_ptr<Segment>> segments_;
+
+    // Tail outputs scheduled by the segments, indexed by absolute time.
+    std::vector<float> tailOut_;
+    std::size_t tailMask_ = 0;
+    std::size_t time_ = 0;
+
+    // Zero-folded IRs being transformed into the inactive filter set.
+    std::vector<float> staging_;
+    std::array<std::size_t, kBands> stagingSize_ {};
+    std::size_t transformTotal_ = 0;
+    std::size_t transformDone_ = 0;
+    std::size_t transformElapsed_ = 0;
+    bool transformActive_ = false;
+};
+
+} // namespace verbsuite
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "VerbSuite/BandConvolver.h"
+#include "VerbSuite/FFT.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace verbsuite {
+
+// Uniformly-partitioned overlap-save (UPOLS) convolution of one input against
+// three band IRs. Input is pushed a sample at a time and each band's output
+// lags by partitionSize() samples. New IRs are transformed a few partitions per
+// block, so replacing a 13k-tap IR never lands in a single callback, and the
+// first block on the new filters is crossfaded from the old ones.
+class PartitionedConvolver final : public BandConvolver {
+public:
+    PartitionedConvolver(std::size_t partitionSize, std::size_t maxIRLength);
+
+    [[nodiscard]] std::size_t partitionSize() const noexcept { return partitionSize_; }
+    [[nodiscard]] std::size_t latencySamples() const noexcept override { return partitionSize_; }
+    [[nodiscard]] bool readyForIRs() const noexcept override { return !transformActive_ && !crossfadePending_; }
+
+    void setIRs(const std::array<ConvolverBandIR, kBands>& bands) override;
+    void loadIRs(const std::array<ConvolverBandIR, kBands>& bands) override;
+    void reset() override;
+    void process(float input, float* bandOut) override;
+
+private:
+    void stageIRs(const std::array<ConvolverBandIR, kBands>& bands);
+    void transformPartition(std::size_t index);
+    void advanceTransform();
+    void processPartitionBlock();
+    void accumulateBand(std::size_t filterSet, std::size_t band, float* out);
+
+    [[nodiscard]] std::size_t filterOffset(std::size_t band, std::size_t partition) const noexcept;
+
+    std::size_t partitionSize_;
+    std::size_t fftSize_;
+    std::size_t numBins_;
+    std::size_t numPartitions_;
+    std::size_t transformsPerBlock_;
+
+    RealFFT fft_;
+
+    std::vector<float> inputBlock_;
+    std::size_t inputPos_ = 0;
+
+    // Frequency-domain delay line, newest spectrum at fdlHead_.
+    std::vector<float> fdlRe_;
+    std::vector<float> fdlIm_;
+    std::size_t fdlHead_ = 0;
+
+    // Two filter sets: the active one and the one being transformed.
+    std::array<std::vector<float>, 2> filterRe_;
+    std::array<std::vector<float>, 2> filterIm_;
+    std::array<std::array<std::size_t, kBands>, 2> bandPartitions_ {};
+    std::size_t activeFilter_ = 0;
+
+    std::vector<float> staging_;
+    std::array<std::size_t, kBands> stagingSize_ {};
+    std::size_t transformCursor_ = 0;
+    bool transformActive_ = false;
+    bool crossfadePending_ = false;
+
+    std::vector<float> accRe_;
+    std::vector<float> accIm_;
+    std::vector<float> timeScratch_;
+    std::vector<float> crossfadeScratch_;
+    std::vector<float> output_;
+};
+
+} // namespace verbsuite
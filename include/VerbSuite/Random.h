@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace verbsuite {
+
+// xoshiro128** generator for the engine's random draws. Seeding goes through
+// splitmix64, so any 64-bit seed gives a well-mixed state; stream k starts
+// k * 2^64 draws into the sequence, so streams of the same seed never overlap.
+// Seeding costs one jump() per stream index, so keep indices small.
+class RandomStream {
+public:
+    explicit RandomStream(std::uint64_t seedValue = 0, std::uint32_t stream = 0) noexcept { seed(seedValue, stream); }
+
+    void seed(std::uint64_t seedValue, std::uint32_t stream = 0) noexcept;
+
+    // Advance by 2^64 and 2^96 draws. A copy taken before the jump owns the
+    // skipped range.
+    void jump() noexcept;
+    void longJump() noexcept;
+
+    // Returns a stream that continues from here and advances this one past it.
+    [[nodiscard]] RandomStream split() noexcept {
+        RandomStream child = *this;
+        jump();
+        return child;
+    }
+
+    [[nodiscard]] std::uint32_t next() noexcept {
+        const std::uint32_t result = rotl(state_[1] * 5u, 7) * 9u;
+        const std::uint32_t t = state_[1] << 9;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 11);
+        return result;
+    }
+
+    // Uniform in [0, 1) with 24 bits of resolution.
+    [[nodiscard]] float uniform() noexcept {
+        return static_cast<float>(next() >> 8) * 0x1.0p-24f;
+    }
+
+    [[nodiscard]] float uniform(float lo, float hi) noexcept {
+        return lo + uniform() * (hi - lo);
+    }
+
+    // The next `count` uniform() draws, in order.
+    void fill(float* out, std::size_t count) noexcept;
+
+private:
+    void jumpBy(const std::uint32_t (&polynomial)[4]) noexcept;
+
+    [[nodiscard]] static constexpr std::uint32_t rotl(std::uint32_t x, int k) noexcept {
+        return (x << k) | (x >> (32 - k));
+    }
+
+    std::uint32_t state_[4] {};
+};
+
+} // namespace verbsuite
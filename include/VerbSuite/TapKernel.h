@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace verbsuite {
+
+// Instruction sets the strided direct-form kernel can run on. Scalar is always
+// available; the others are picked at runtime when the CPU supports them.
+enum class TapKernel : std::uint8_t {
+    Scalar,
+    SSE2,
+    AVX2,
+    NEON
+};
+
+// One band of the lo-fi direct-form convolution. Both histories are mirrored
+// (every sample written twice, one history length apart), so `input` and
+// `feedback` point at the newest sample and older ones sit at negative offsets
+// with no wraparound. Tap i reads IR tap k = i * stride:
+//   x = input[-max(k - zeroIndex, 0)] + feedback[-k] * feedbackAmount
+struct StridedTaps {
+    const float* input = nullptr;
+    const float* feedback = nullptr; // nullptr when the mode has no feedback
+    float feedbackAmount = 0.0f;
+    const float* ir = nullptr;
+    std::size_t zeroIndex = 0;
+    std::size_t stride = 1;
+    std::size_t count = 0;
+};
+
+// The three bands of one refreshed sample. They share the stride and feedback
+// and differ only in zero index and tap count, so one pass over the histories
+// serves all three. IR taps are pre-packed by packStridedIRs() as four floats
+// per tap: low, mid, high, unused.
+struct FusedStridedTaps {
+    static constexpr std::size_t kBands = 3;
+    static constexpr std::size_t kLanes = 4;
+
+    const float* input = nullptr;
+    const float* feedback = nullptr;
+    float feedbackAmount = 0.0f;
+    const float* packedIR = nullptr;
+    std::array<std::size_t, kBands> zeroIndex {};
+    std::array<std::size_t, kBands> count {};
+    std::size_t stride = 1;
+};
+
+// One strided IR per channel, run over every channel at once. Channels sit
+// side by side in `lanes` floats (a multiple of kLaneWidth, padding lanes
+// zero): `history` is mirrored like the band histories and points at the
+// newest frame, older frames sitting `lanes` floats apart at negative offsets;
+// `packedIR` holds one frame of taps per tap. Tap i reads the frame
+// i * stride back.
+struct ChannelStridedTaps {
+    static constexpr std::size_t kLaneWidth = 4;
+    static constexpr std::size_t kMaxLanes = 16;
+
+    const float* history = nullptr;
+    const float* packedIR = nullptr;
+    std::size_t lanes = kLaneWidth;
+    std::size_t stride = 1;
+    std::size_t count = 0;
+};
+
+[[nodiscard]] bool tapKernelSupported(TapKernel kernel) noexcept;
+[[nodiscard]] TapKernel bestTapKernel() noexcept;
+[[nodiscard]] const char* tapKernelName(TapKernel kernel) noexcept;
+
+// Sum of x * ir over the taps. The SIMD kernels only vectorise the gathers and
+// the feedback mix; products are accumulated in tap order, so every kernel is
+// bit-identical to the scalar loop. Unsupported kernels fall back to Scalar.
+[[nodiscard]] float stridedTapSum(const StridedTaps& taps) noexcept;
+[[nodiscard]] float stridedTapSum(const StridedTaps& taps, TapKernel kernel) noexcept;
+
+// Writes every stride-th tap of the three IRs into packed (kLanes floats per
+// tap, `count` taps); bands shorter than count are zero padded.
+void packStridedIRs(const std::array<const float*, FusedStridedTaps::kBands>& irs,
+    const std::array<std::size_t, FusedStridedTaps::kBands>& sizes,
+    std::size_t stride,
+    std::size_t count,
+    float* packed) noexcept;
+
+// Fused form of three stridedTapSum() calls. Each band is still accumulated in
+// tap order (one vector lane per band), so results are bit-identical.
+void fusedTapSum(const FusedStridedTaps& taps, float* wet) noexcept;
+void fusedTapSum(const FusedStridedTaps& taps, float* wet, TapKernel kernel) noexcept;
+
+// Writes each lane's tap sum to wet[0, lanes). A tap costs one vector
+// multiply-add per kLaneWidth channels (two per AVX2 register), so four or
+// eight channels cost about what one does. Lanes accumulate in tap order and
+// every kernel is bit-identical to the scalar loop.
+void channelTapSum(const ChannelStridedTaps& taps, float* wet) noexcept;
+void channelTapSum(const ChannelStridedTaps& taps, float* wet, TapKernel kernel) noexcept;
+
+} // namespace verbsuite
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace verbsuite {
+
+enum class WeirdMode : std::uint8_t {
+    LivingSignal,
+    UncannyCausality,
+    SpectralGhost,
+    RainforestMemory,
+    ProcessImprint,
+    DigitalFailure,
+    AntiSpace,
+    Afterimage,
+    HabitRoom
+};
+
+struct WeirdControls {
+    float memory = 0.5f;      // Replaces room size.
+    float coherence = 0.5f;   // Phase/image lock.
+    float entropy = 0.5f;     // Disorder probability.
+    float resistance = 0.5f;  // Feedback damping.
+    float stability = 0.5f;   // Realistic -> unstable -> autonomous.
+    float breathRateHz = 0.25f;
+    float breathDepth = 1.0f;
+    float breathBeats = 1.0f; // Used when tempoSync is true.
+    float bpm = 120.0f;
+    bool tempoSync = false;
+    bool wildIrBank = false;
+    bool freeze = false;
+    float wet = 0.7f;
+    float dry = 0.3f;
+
+    [[nodiscard]] bool operator==(const WeirdControls&) const = default;
+};
+
+} // namespace verbsuite
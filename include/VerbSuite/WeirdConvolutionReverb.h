@@ -1,88 +1,313 @@
 #pragma once
 
+#include "VerbSuite/BandConvolver.h"
+#include "VerbSuite/BlockProfiler.h"
+#include "VerbSuite/ControlBlock.h"
+#include "VerbSuite/IRBank.h"
+#include "VerbSuite/IRSynthesisWorker.h"
+#include "VerbSuite/LivingIRSynth.h"
+#include "VerbSuite/Random.h"
+#include "VerbSuite/TapKernel.h"
+#include "VerbSuite/WeirdControls.h"
+
+#include <array>
 #include <cstddef>
 #include <cstdint>
-#include <random>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace verbsuite {
 
-enum class WeirdMode : std::uint8_t {
-    LivingSignal,
-    UncannyCausality,
-    SpectralGhost,
-    RainforestMemory,
-    ProcessImprint,
-    DigitalFailure,
-    AntiSpace,
-    Afterimage,
-    HabitRoom
+// Where living-IR regeneration runs. Inline keeps renders bit-reproducible;
+// Background moves the work to a worker thread and lets the audio thread keep
+// the previous IRs whenever the worker is late. Amortized stays on the audio
+// thread but spreads each update across the chunks up to the next update point,
+// building into a back buffer that swaps in once complete; it is reproducible
+// too, though not identical to Inline. SharedPool behaves like Background but
+// runs on IRSynthesisPool::shared(), whose few threads serve every engine in
+// the process in order of their next update point.
+enum class IRSynthesisMode : std::uint8_t {
+    Inline,
+    Background,
+    Amortized,
+    SharedPool
+};
+
+// Backend for the three band convolutions. Direct is the strided, tap-capped
+// lo-fi kernel; Partitioned runs the full living IRs through a UPOLS engine at a
+// flat per-sample cost and delays the wet path by one partition; NonUniform
+// runs the full IRs with a direct-form head and growing FFT partitions, adding
+// no latency at a somewhat higher cost.
+enum class ConvolutionEngine : std::uint8_t {
+    Direct,
+    Partitioned,
+    NonUniform
 };
 
-struct WeirdControls {
-    float memory = 0.5f;      // Replaces room size.
-    float coherence = 0.5f;   // Phase/image lock.
-    float entropy = 0.5f;     // Disorder probability.
-    float resistance = 0.5f;  // Feedback damping.
-    float stability = 0.5f;   // Realistic -> unstable -> autonomous.
-    float breathRateHz = 0.25f;
-    float breathDepth = 1.0f;
-    float breathBeats = 1.0f; // Used when tempoSync is true.
-    float bpm = 120.0f;
-    bool tempoSync = false;
-    bool wildIrBank = false;
-    bool freeze = false;
-    float wet = 0.7f;
-    float dry = 0.3f;
+// Signal state one engine hands to another, possibly at another rate, so an
+// engine built mid-stream (e.g. an oversampled one) continues the tail and the
+// tracked features instead of starting cold.
+struct EngineWarmState {
+    double sampleRate = 0.0;
+    // Input and wet feedback histories, oldest sample first.
+    std::vector<float> input;
+    std::vector<float> feedback;
+    std::size_t frames = 0;
+    float featureEnvelope = 0.0f;
+    float featureBrightness = 0.0f;
+    float previousMono = 0.0f;
+    float learnedBias = 0.0f;
+    float autonomousDronePhase = 0.0f;
+    float lpState = 0.0f;
+    float hpState = 0.0f;
+    float dynamicStability = 0.5f;
+    float lofiWowPhase = 0.0f;
+};
+
+// Wall time (seconds) processBlock() spent in each stage while stage timing is
+// enabled. In sample-serial chunks the stages are timed one sample at a time,
+// so the clock overhead lands in the totals too. The multichannel form's
+// per-channel convolution replaces the output stage and is timed as output.
+struct StageTimings {
+    double input = 0.0;
+    double irUpdate = 0.0;
+    double bandSplit = 0.0;
+    double convolution = 0.0;
+    double texture = 0.0;
+    double quantize = 0.0;
+    double output = 0.0;
+    std::uint64_t samples = 0;
 };
 
 class WeirdConvolutionReverb {
 public:
     WeirdConvolutionReverb(double sampleRate, std::size_t blockSize, WeirdMode mode);
 
+    // Audio thread. Other threads publish to controlBlock() instead.
     void setMode(WeirdMode newMode);
     void setControls(const WeirdControls& newControls);
+    // Lock-free settings inbox, drained at the start of every processBlock().
+    // One control thread at a time may publish to it while the engine runs.
+    [[nodiscard]] ControlBlock& controlBlock() noexcept { return controlBlock_; }
+    // Audio thread. Queues a change `event.offset` samples into the next
+    // processBlock(), which splits its work there so the change lands on that
+    // sample (and starts a control tick). Events at one offset apply in queue
+    // order; offsets past the block apply after it. Returns false when
+    // kMaxControlEvents events are already queued.
+    bool queueControlEvent(const ControlEvent& event) noexcept;
+    static constexpr std::size_t kMaxControlEvents = 256;
+    // Ramp time for the continuous controls (memory, coherence, entropy,
+    // resistance, stability, breath depth, dry, wet) when new controls arrive.
+    // 0, the default, applies them at once, as do the first controls after
+    // reset(). Dry and wet ramp per sample, the rest at control ticks.
+    void setControlSmoothing(double seconds) noexcept;
+
+    // Not realtime-safe: starts or joins the worker thread, or sizes the
+    // amortized back buffer. Call while the engine is not processing (e.g. from
+    // prepare).
+    void setIRSynthesisMode(IRSynthesisMode newMode);
+    [[nodiscard]] IRSynthesisMode irSynthesisMode() const noexcept;
+
+    // Not realtime-safe: allocates the backend's spectra. Once a backend has been
+    // prepared, switching to it with setConvolutionEngine() only reloads its IRs.
+    void prepareConvolutionEngine(ConvolutionEngine engine);
+    void setConvolutionEngine(ConvolutionEngine newEngine);
+    [[nodiscard]] ConvolutionEngine convolutionEngine() const noexcept;
+    // Extra delay the wet path adds on top of the dry signal.
+    [[nodiscard]] std::size_t latencySamples() const noexcept;
+
+    // Not realtime-safe. Replaces the source IRs the living IRs morph between
+    // (IRBank::kCoreCount + IRBank::kWildCount entries, else
+    // std::invalid_argument); IRs at another rate are resampled to this
+    // engine's. Resets the engine and rebuilds prepared convolution backends.
+    void setIRBank(std::shared_ptr<const IRBank> bank);
+    // Not realtime-safe. Memory-maps a bank file (see IRBank) and installs it.
+    // Throws std::runtime_error when the file is missing or malformed.
+    void loadIRBank(const std::string& path);
+    [[nodiscard]] const std::shared_ptr<const IRBank>& irBank() const noexcept { return irBank_; }
+
+    // Not realtime-safe. Selects the random sequence the engine draws from; the
+    // draws restart at reset(), so a render that begins with reset() repeats
+    // exactly for the same seed and stream. Give each instance that shares a
+    // seed its own stream index to keep their sequences apart.
+    void setRandomSeed(std::uint64_t seed, std::uint32_t stream = 0);
+    [[nodiscard]] std::uint64_t randomSeed() const noexcept { return seed_; }
+    [[nodiscard]] std::uint32_t randomStream() const noexcept { return stream_; }
+
+    // Not realtime-safe: sizes `state` for captureWarmState().
+    void prepareWarmState(EngineWarmState& state) const;
+    // Realtime-safe once `state` has been prepared by this engine.
+    void captureWarmState(EngineWarmState& state) const noexcept;
+    // Not realtime-safe. Resamples the captured histories to this engine's
+    // rate and takes over the tracked features; mode, controls and IRs are
+    // left as they are, and the next IR update picks the features up.
+    void warmStart(const EngineWarmState& state);
+
+    void setStageTimingEnabled(bool enabled) noexcept { timingEnabled_ = enabled; }
+    [[nodiscard]] const StageTimings& stageTimings() const noexcept { return timings_; }
+    void resetStageTimings() noexcept { timings_ = {}; }
+
+    // Every processBlock() call pushes one BlockRecord to the attached profiler
+    // (null detaches). Only builds with VERBSUITE_BLOCK_PROFILER record
+    // anything; otherwise the pointer is never read.
+    void setBlockProfiler(BlockProfiler* profiler) noexcept { profiler_ = profiler; }
+    [[nodiscard]] static constexpr bool blockProfilerCompiledIn() noexcept { return VERBSUITE_BLOCK_PROFILER != 0; }
+
+    // Samples per control tick (at least 1). Values derived from the controls
+    // and the CV (stability, lofi depth, hold periods, the quantize step) are
+    // computed at ticks every `samples` samples from the start of each block;
+    // stability and lofi depth ramp to each tick's values across the interval,
+    // the rest hold. 1, the default, recomputes them every sample as before.
+    void setControlInterval(std::size_t samples) noexcept;
+    [[nodiscard]] std::size_t controlInterval() const noexcept { return controlInterval_; }
+
+    // Most channels the multichannel processBlock() takes (9.1.6).
+    static constexpr std::size_t kMaxChannels = ChannelStridedTaps::kMaxLanes;
+    // Not realtime-safe. Sizes the per-channel histories and IRs for the
+    // multichannel processBlock() with up to `channels` channels (1 to
+    // kMaxChannels, else std::invalid_argument).
+    void prepareChannels(std::size_t channels);
+    [[nodiscard]] std::size_t preparedChannels() const noexcept { return channelCount_; }
 
     void reset();
+    // `stabilityCv` is audio-rate; with a control interval above 1 only the
+    // samples at ticks are read.
     void processBlock(float* left, float* right, std::size_t numSamples, const float* stabilityCv = nullptr, float cvAmount = 0.0f);
+    // Same, with the CV at control rate: ceil(numSamples / controlInterval())
+    // values, value k for the tick at sample k * controlInterval(), e.g.
+    // CVFollower::controlRate() with the same interval.
+    void processBlockControlRate(float* left, float* right, std::size_t numSamples, const float* controlCv, float cvAmount);
+    // Multichannel form, for up to preparedChannels() channels; any further
+    // channels are left as they are. Feature tracking, IR synthesis and the
+    // whole wet path run once, on the channels' mean, exactly as the stereo
+    // form runs on its mid. On top of that each channel convolves its own
+    // difference from the mean with its own decorrelated copy of the living
+    // IRs, so discrete content stays in its channel and the channels' tails do
+    // not correlate. With two channels this is true stereo, which the stereo
+    // form (one wet on both sides) is not.
+    void processBlock(float* const* channels, std::size_t numChannels, std::size_t numSamples, const float* stabilityCv = nullptr, float cvAmount = 0.0f);
+    void processBlockControlRate(float* const* channels, std::size_t numChannels, std::size_t numSamples, const float* controlCv, float cvAmount);
 
     [[nodiscard]] std::string modeName() const;
 
-    static constexpr int modeCount() noexcept { return 9; }
+    static constexpr int modeCount() noexcept { return static_cast<int>(kModeCount); }
     static std::string modeName(WeirdMode mode);
     static WeirdMode modeFromIndex(int index);
 
 private:
-    void buildIRBank();
     void updateFeatureTracking(float mono);
-    void updateLivingIR();
-    void applyIRModulation(std::vector<float>& ir);
-    void applySpectralMisalignment(std::vector<float>& ir);
-    void applyElasticTime(std::vector<float>& ir);
+    // processBlock() runs in chunks that never straddle an IR update. Each chunk
+    // goes through the stages below in order; stage state for sample j of the
+    // chunk lives in stage_ and its history slot is historyWrite_ + j. The
+    // stages are instantiated per mode so mode checks resolve at compile time;
+    // processBlock() picks the instantiation from kChunkProcessors once per block.
+    template <WeirdMode M>
+    void processChunk(float* left, float* right, std::size_t blockOffset, std::size_t n, bool updateFirst);
+    template <WeirdMode M>
+    void runInputStage(const float* left, const float* right, std::size_t blockOffset, std::size_t n);
+    void applyControlEvent(const ControlEvent& event) noexcept;
+    // Starts the control interval at sample `blockSample` of the block.
+    template <WeirdMode M>
+    void beginControlInterval(std::size_t blockSample);
+    void runBandSplitStage(std::size_t n);
+    template <WeirdMode M>
+    void runConvolutionStage(std::size_t begin, std::size_t end);
+    template <WeirdMode M>
+    void runTextureStage(std::size_t begin, std::size_t end);
+    template <WeirdMode M>
+    void runQuantizeStage(std::size_t begin, std::size_t end);
+    template <WeirdMode M>
+    void runOutputStage(float* left, float* right, std::size_t blockOffset, std::size_t begin, std::size_t end);
+    // Multichannel form: the per-channel convolution and the output stage.
+    template <WeirdMode M>
+    void runChannelStage(std::size_t blockOffset, std::size_t begin, std::size_t end);
+    void packChannelIRs(std::size_t stride);
+
+    using ChunkProcessor = void (WeirdConvolutionReverb::*)(float*, float*, std::size_t, std::size_t, bool);
+    static constexpr std::size_t kModeCount = 9;
+    static const std::array<ChunkProcessor, kModeCount> kChunkProcessors;
 
-    [[nodiscard]] float convolveSample(float inputSample, const std::vector<float>& ir, std::size_t zeroIndex);
-    [[nodiscard]] float sampleHistory(int delay) const;
-    [[nodiscard]] float randomUniform(float lo, float hi);
+    // Only Inline and Amortized synthesize on the engine's own irSynth_; the
+    // worker modes leave its workspace unallocated.
+    [[nodiscard]] bool synthesizesInline() const noexcept;
+    void updateLivingIR(const LivingIRSnapshot& snapshot);
+    // Amortized synthesis: runs this chunk's share of the pending job.
+    void advancePendingIR(std::size_t n);
+    void installPendingIR();
+    [[nodiscard]] LivingIRSnapshot captureIRSnapshot(std::size_t j) const;
+    [[nodiscard]] FeedbackView feedbackView() const;
 
-    static std::vector<float> generateIR(std::size_t length, float decaySeconds, float diffusion, float tone);
-    static std::vector<float> generateMorseIR(std::size_t length, float density);
-    static std::vector<float> generateBodyIR(std::size_t length, float pulseHz);
-    static std::vector<float> morphIR(const std::vector<float>& a, const std::vector<float>& b, float t);
+    // Per-band direct path; only Digital Failure uses it, since it drops taps at
+    // random and must keep the order of RNG draws.
+    [[nodiscard]] float convolveSample(std::size_t j, float inputSample, const std::vector<float>& ir, std::size_t zeroIndex);
+    // All three bands in one pass over the histories.
+    template <WeirdMode M>
+    [[nodiscard]] std::array<float, FusedStridedTaps::kBands> convolveBands(
+        std::size_t j,
+        const std::array<float, FusedStridedTaps::kBands>& bandInput,
+        const std::array<const std::vector<float>*, FusedStridedTaps::kBands>& irs,
+        const std::array<std::size_t, FusedStridedTaps::kBands>& zeroIndex,
+        bool swapBands);
+    template <WeirdMode M>
+    [[nodiscard]] float finishConvolution(std::size_t j, float wet, float inputSample) const;
+    [[nodiscard]] float feedbackAmount() const;
+    [[nodiscard]] std::size_t tapStride() const;
+    [[nodiscard]] std::array<ConvolverBandIR, BandConvolver::kBands> convolverBands(bool swapBands) const;
+    [[nodiscard]] float sampleHistory(std::size_t write, int delay) const;
+    // The audio thread draws from stream_ of seed_; the background worker or
+    // the amortized job from the same stream 2^96 draws further on.
+    [[nodiscard]] RandomStream workerRandomStream() const;
 
     double sampleRate_;
     std::size_t blockSize_;
 
     WeirdMode mode_;
+    // The continuous fields hold the smoothed values, not the latest targets.
     WeirdControls controls_;
+    ControlBlock controlBlock_;
+    EngineSettings inbox_;
+    // Queued for the next block, in offset order.
+    std::array<ControlEvent, kMaxControlEvents> events_ {};
+    std::size_t eventCount_ = 0;
 
-    std::vector<std::vector<float>> irBank_;
-    std::vector<float> activeIRLow_;
-    std::vector<float> activeIRMid_;
-    std::vector<float> activeIRHigh_;
+    // Ramps for kSmoothedControls; dry and wet are the last two and advance in
+    // the output stage, the others at control ticks.
+    static constexpr std::size_t kSmoothedControlCount = 8;
+    static constexpr std::size_t kTickSmoothedControls = 6;
+    static const std::array<float WeirdControls::*, kSmoothedControlCount> kSmoothedControls;
+    std::array<LinearRamp, kSmoothedControlCount> controlRamps_;
+    std::size_t controlSmoothingSamples_ = 0;
+    bool tickRampsActive_ = false;
+    bool snapControls_ = true;
 
+    // Shared with every other engine at this sample rate; irSynth_ and the
+    // worker hold references into it.
+    std::shared_ptr<const IRBank> irBank_;
+    LivingIRSet activeIR_;
+    // Bumped whenever activeIR_ changes; the fused kernel's packed taps follow it.
+    std::uint64_t irVersion_ = 0;
+    std::vector<float> packedIR_;
+    std::uint64_t packedVersion_ = ~std::uint64_t { 0 };
+    std::size_t packedStride_ = 0;
+    bool packedSwapBands_ = false;
+    LivingIRSynth irSynth_;
+    std::size_t irCapacity_ = 0;
+
+    IRSynthesisMode irSynthesisMode_ = IRSynthesisMode::Inline;
+    // Amortized synthesis: the set irSynth_ is building, its draws, and the
+    // samples left until it must be done.
+    LivingIRSet pendingIR_;
+    RandomStream pendingRng_;
+    std::size_t pendingSamplesLeft_ = 0;
+    // Samples between IR updates for the current block.
+    std::size_t updateRate_ = 1;
+
+    // Mirrored histories: sample i lives at i and i + historySize_, so the tap
+    // kernel reads any delay up to historySize_ without wrapping.
     std::vector<float> inputHistory_;
     std::vector<float> feedbackHistory_;
+    std::size_t historySize_ = 0;
     std::size_t historyWrite_ = 0;
 
     float featureEnvelope_ = 0.0f;
@@ -95,15 +320,98 @@ private:
     float hpState_ = 0.0f;
 
     std::size_t frameCounter_ = 0;
-    std::size_t zeroIndex_ = 0;
     float dynamicStability_ = 0.5f;
     std::size_t lofiHoldCounter_ = 0;
     std::size_t lofiHoldPeriod_ = 1;
+    // lofiHoldCounter_ % lofiHoldPeriod_, kept incrementally.
+    std::size_t lofiHoldPhase_ = 0;
+
+    // The current block's CV: audio-rate, or one value per control tick.
+    const float* blockCv_ = nullptr;
+    bool blockCvControlRate_ = false;
+    float blockCvAmount_ = 0.0f;
+    std::size_t blockSamples_ = 0;
+
+    // Control-rate layer. Stability and lofi depth step towards the tick's
+    // targets and land on them on the interval's last sample.
+    struct ControlState {
+        float stability = 0.5f;
+        float stabilityTarget = 0.5f;
+        float stabilityStep = 0.0f;
+        float lofiDepth = 0.0f;
+        float lofiDepthTarget = 0.0f;
+        float lofiDepthStep = 0.0f;
+        std::size_t samplesLeft = 0;
+        float loFiStep = 1.0f;
+        std::size_t quantizePeriod = 2;
+        // (block sample) % quantizePeriod, kept incrementally.
+        std::size_t quantizePhase = 0;
+    };
+    std::size_t controlInterval_ = 1;
+    ControlState control_;
     float lofiInputHeld_ = 0.0f;
     float lofiWetHeld_ = 0.0f;
     float lofiWowPhase_ = 0.0f;
 
-    std::mt19937 rng_;
+    static constexpr std::uint64_t kDefaultSeed = 0xC0FFEEu;
+    std::uint64_t seed_ = kDefaultSeed;
+    std::uint32_t stream_ = 0;
+    RandomStream rng_;
+
+    // Per-sample values handed from one stage to the next within a chunk.
+    struct StageBuffers {
+        std::vector<float> stability;
+        std::vector<float> lofiDepth;
+        std::vector<std::uint8_t> refresh;
+        // Quantize stage: its step, and whether the sample keeps the held wet.
+        std::vector<float> loFiStep;
+        std::vector<std::uint8_t> quantizeHold;
+        std::vector<float> mono;
+        // Multichannel form: the mean of the input channels.
+        std::vector<float> downmix;
+        std::vector<float> envelope;
+        std::vector<float> brightness;
+        std::vector<std::size_t> frame;
+        std::vector<float> low;
+        std::vector<float> mid;
+        std::vector<float> high;
+        std::vector<float> wet;
+        std::vector<float> held;
+
+        void prepare(std::size_t size);
+    };
+    StageBuffers stage_;
+    bool timingEnabled_ = false;
+    StageTimings timings_;
+    BlockProfiler* profiler_ = nullptr;
+    // BlockEvent bits gathered during the current block.
+    std::uint8_t blockEvents_ = 0;
+
+    // Multichannel form. Each channel's difference from the mean goes into a
+    // short mirrored history, channelLanes_ floats per frame, and is convolved
+    // with the strided living IR times that channel's fixed random signs.
+    std::size_t channelCount_ = 0;
+    std::size_t channelLanes_ = 0;
+    std::vector<float> channelHistory_;
+    std::size_t channelWrite_ = 0;
+    std::vector<float> channelSigns_;
+    std::vector<float> channelIR_;
+    std::uint64_t channelPackedVersion_ = ~std::uint64_t { 0 };
+    std::size_t channelPackedStride_ = 0;
+    std::array<float, kMaxChannels> channelHeld_ {};
+    // The current block's channels, or null in the stereo form.
+    float* const* blockChannels_ = nullptr;
+    std::size_t blockChannelCount_ = 0;
+
+    std::unique_ptr<BandConvolver> partitionedConvolver_;
+    std::unique_ptr<BandConvolver> nonUniformConvolver_;
+    BandConvolver* convolver_ = nullptr;
+    ConvolutionEngine engine_ = ConvolutionEngine::Direct;
+    bool convolverDirty_ = false;
+    bool convolverSwapBands_ = false;
+
+    // Declared last so the worker is joined before the bank it reads is destroyed.
+    std::unique_ptr<IRSynthesisWorker> irWorker_;
 };
 
 } // namespace verbsuite
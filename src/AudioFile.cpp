@@ -0,0 +1,412 @@
+#include "VerbSuite/AudioFile.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace verbsuite {
+namespace {
+static_assert(std::endian::native == std::endian::little, "WAV samples are little-endian");
+
+constexpr std::uint16_t kTagPcm = 1;
+constexpr std::uint16_t kTagFloat = 3;
+constexpr std::uint16_t kTagExtensible = 0xFFFE;
+// KSDATAFORMAT_SUBTYPE_* GUIDs after their leading format tag.
+constexpr unsigned char kSubFormatTail[14] = { 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 };
+constexpr std::uint32_t kJunkSize = 28; // Room for a ds64 body without a table.
+constexpr std::uint32_t kUnknownSize = 0xFFFFFFFFu;
+
+std::uint16_t readU16(const unsigned char* p) {
+    std::uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+std::uint32_t readU32(const unsigned char* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+std::uint64_t readU64(const unsigned char* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+template <typename T>
+void append(std::vector<unsigned char>& out, T value) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void appendId(std::vector<unsigned char>& out, const char (&id)[5]) {
+    out.insert(out.end(), id, id + 4);
+}
+
+template <typename T>
+void writeAt(std::ofstream& out, std::uint64_t offset, T value) {
+    out.seekp(static_cast<std::streamoff>(offset));
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+std::uint16_t formatTag(SampleFormat format) {
+    return format == SampleFormat::Float32 ? kTagFloat : kTagPcm;
+}
+
+// Clips to [-1, 1], scales and rounds half away from zero.
+template <typename Int, typename Real>
+Int quantize(float x, Real scale) {
+    const Real v = static_cast<Real>(std::clamp(x, -1.0f, 1.0f)) * scale;
+    return static_cast<Int>(v + std::copysign(Real(0.5), v));
+}
+
+template <SampleFormat Format>
+void encodeSample(float x, unsigned char* p) {
+    if constexpr (Format == SampleFormat::Float32) {
+        std::memcpy(p, &x, sizeof(x));
+    } else if constexpr (Format == SampleFormat::Int16) {
+        const auto v = quantize<std::int16_t>(x, 32767.0f);
+        std::memcpy(p, &v, sizeof(v));
+    } else if constexpr (Format == SampleFormat::Int24) {
+        const auto v = static_cast<std::uint32_t>(quantize<std::int32_t>(x, 8388607.0f));
+        p[0] = static_cast<unsigned char>(v);
+        p[1] = static_cast<unsigned char>(v >> 8);
+        p[2] = static_cast<unsigned char>(v >> 16);
+    } else {
+        const auto v = quantize<std::int32_t>(x, 2147483647.0);
+        std::memcpy(p, &v, sizeof(v));
+    }
+}
+
+template <SampleFormat Format>
+float decodeSample(const unsigned char* p) {
+    if constexpr (Format == SampleFormat::Float32) {
+        float v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    } else if constexpr (Format == SampleFormat::Int16) {
+        return static_cast<float>(static_cast<std::int16_t>(readU16(p))) / 32768.0f;
+    } else if constexpr (Format == SampleFormat::Int24) {
+        const std::uint32_t bits = static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) | (static_cast<std::uint32_t>(p[2]) << 16);
+        return static_cast<float>(static_cast<std::int32_t>(bits << 8) >> 8) / 8388608.0f;
+    } else {
+        return static_cast<float>(static_cast<std::int32_t>(readU32(p))) / 2147483648.0f;
+    }
+}
+
+// Interleaves channels[c][offset..offset + frames) into `out`.
+template <SampleFormat Format>
+void encodeFrames(const float* const* channels, std::size_t offset, std::size_t channelCount, std::size_t frames, unsigned char* out) {
+    constexpr std::size_t sampleBytes = Format == SampleFormat::Int16 ? 2 : (Format == SampleFormat::Int24 ? 3 : 4);
+    const std::size_t frameBytes = sampleBytes * channelCount;
+    for (std::size_t c = 0; c < channelCount; ++c) {
+        const float* src = channels[c] + offset;
+        unsigned char* dst = out + c * sampleBytes;
+        for (std::size_t i = 0; i < frames; ++i) {
+            encodeSample<Format>(src[i], dst + i * frameBytes);
+        }
+    }
+}
+
+// Splits `frames` interleaved frames from `in` into channels[c][offset..].
+template <SampleFormat Format>
+void decodeFrames(const unsigned char* in, std::size_t channelCount, std::size_t frames, float* const* channels, std::size_t offset) {
+    constexpr std::size_t sampleBytes = Format == SampleFormat::Int16 ? 2 : (Format == SampleFormat::Int24 ? 3 : 4);
+    const std::size_t frameBytes = sampleBytes * channelCount;
+    for (std::size_t c = 0; c < channelCount; ++c) {
+        const unsigned char* src = in + c * sampleBytes;
+        float* dst = channels[c] + offset;
+        for (std::size_t i = 0; i < frames; ++i) {
+            dst[i] = decodeSample<Format>(src + i * frameBytes);
+        }
+    }
+}
+
+void encode(SampleFormat format, const float* const* channels, std::size_t offset, std::size_t channelCount, std::size_t frames, unsigned char* out) {
+    switch (format) {
+    case SampleFormat::Int16: encodeFrames<SampleFormat::Int16>(channels, offset, channelCount, frames, out); break;
+    case SampleFormat::Int24: encodeFrames<SampleFormat::Int24>(channels, offset, channelCount, frames, out); break;
+    case SampleFormat::Int32: encodeFrames<SampleFormat::Int32>(channels, offset, channelCount, frames, out); break;
+    case SampleFormat::Float32: encodeFrames<SampleFormat::Float32>(channels, offset, channelCount, frames, out); break;
+    }
+}
+
+void decode(SampleFormat format, const unsigned char* in, std::size_t channelCount, std::size_t frames, float* const* channels, std::size_t offset) {
+    switch (format) {
+    case SampleFormat::Int16: decodeFrames<SampleFormat::Int16>(in, channelCount, frames, channels, offset); break;
+    case SampleFormat::Int24: decodeFrames<SampleFormat::Int24>(in, channelCount, frames, channels, offset); break;
+    case SampleFormat::Int32: decodeFrames<SampleFormat::Int32>(in, channelCount, frames, channels, offset); break;
+    case SampleFormat::Float32: decodeFrames<SampleFormat::Float32>(in, channelCount, frames, channels, offset); break;
+    }
+}
+
+} // namespace
+
+std::size_t bytesPerSample(SampleFormat format) noexcept {
+    switch (format) {
+    case SampleFormat::Int16: return 2;
+    case SampleFormat::Int24: return 3;
+    case SampleFormat::Int32: return 4;
+    case SampleFormat::Float32: return 4;
+    }
+    return 4;
+}
+
+const char* sampleFormatName(SampleFormat format) noexcept {
+    switch (format) {
+    case SampleFormat::Int16: return "int16";
+    case SampleFormat::Int24: return "int24";
+    case SampleFormat::Int32: return "int32";
+    case SampleFormat::Float32: return "float32";
+    }
+    return "float32";
+}
+
+AudioFileWriter::AudioFileWriter(const std::string& path, int sampleRate, std::size_t channels, SampleFormat format)
+    : path_(path)
+    , channels_(channels)
+    , format_(format)
+    , frameBytes_(channels * bytesPerSample(format)) {
+    if (channels == 0 || channels > 0xFFFF || frameBytes_ > 0xFFFF || sampleRate <= 0) {
+        throw std::invalid_argument("Unsupported WAV layout for " + path);
+    }
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_) {
+        throw std::runtime_error("Failed to open " + path + " for writing");
+    }
+
+    const auto bits = static_cast<std::uint16_t>(8 * bytesPerSample(format));
+    const bool extensible = channels > 2;
+    std::vector<unsigned char> header;
+    header.reserve(96);
+    appendId(header, "RIFF");
+    append<std::uint32_t>(header, 0);
+    appendId(header, "WAVE");
+    appendId(header, "JUNK");
+    append<std::uint32_t>(header, kJunkSize);
+    header.resize(header.size() + kJunkSize, 0);
+    appendId(header, "fmt ");
+    append<std::uint32_t>(header, extensible ? 40 : 16);
+    append<std::uint16_t>(header, extensible ? kTagExtensible : formatTag(format));
+    append<std::uint16_t>(header, static_cast<std::uint16_t>(channels));
+    append<std::uint32_t>(header, static_cast<std::uint32_t>(sampleRate));
+    append<std::uint32_t>(header, static_cast<std::uint32_t>(sampleRate) * static_cast<std::uint32_t>(frameBytes_));
+    append<std::uint16_t>(header, static_cast<std::uint16_t>(frameBytes_));
+    append<std::uint16_t>(header, bits);
+    if (extensible) {
+        append<std::uint16_t>(header, 22);
+        append<std::uint16_t>(header, bits);
+        append<std::uint32_t>(header, 0); // No speaker mapping.
+        append<std::uint16_t>(header, formatTag(format));
+        header.insert(header.end(), std::begin(kSubFormatTail), std::end(kSubFormatTail));
+    }
+    appendId(header, "data");
+    dataSizeOffset_ = header.size();
+    append<std::uint32_t>(header, 0);
+    out_.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+    buffer_.resize(std::max<std::size_t>(1, kBufferBytes / frameBytes_) * frameBytes_);
+}
+
+AudioFileWriter::~AudioFileWriter() {
+    if (out_.is_open()) {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+}
+
+void AudioFileWriter::write(const float* const* channels, std::size_t frames) {
+    const std::size_t capacity = buffer_.size() / frameBytes_;
+    std::size_t done = 0;
+    while (done < frames) {
+        const std::size_t n = std::min(frames - done, capacity - buffered_);
+        encode(format_, channels, done, channels_, n, buffer_.data() + buffered_ * frameBytes_);
+        buffered_ += n;
+        done += n;
+        if (buffered_ == capacity) {
+            flush();
+        }
+    }
+    frames_ += frames;
+}
+
+void AudioFileWriter::flush() {
+    if (buffered_ == 0) {
+        return;
+    }
+    out_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffered_ * frameBytes_));
+    buffered_ = 0;
+    if (!out_) {
+        throw std::runtime_error("Failed to write " + path_);
+    }
+}
+
+void AudioFileWriter::close() {
+    if (!out_.is_open()) {
+        return;
+    }
+    flush();
+    const std::uint64_t dataBytes = frames_ * frameBytes_;
+    const std::uint64_t pad = dataBytes & 1u;
+    if (pad != 0) {
+        out_.put('\0');
+    }
+    const std::uint64_t riffSize = dataSizeOffset_ + 4 + dataBytes + pad - 8;
+    if (riffSize > kUnknownSize) {
+        // RF64: the 32-bit sizes become placeholders and the JUNK chunk turns
+        // into the ds64 chunk carrying the real ones.
+        out_.seekp(0);
+        out_.write("RF64", 4);
+        writeAt<std::uint32_t>(out_, 4, kUnknownSize);
+        out_.seekp(12);
+        out_.write("ds64", 4);
+        writeAt<std::uint64_t>(out_, 20, riffSize);
+        writeAt<std::uint64_t>(out_, 28, dataBytes);
+        writeAt<std::uint64_t>(out_, 36, frames_);
+        writeAt<std::uint32_t>(out_, 44, 0);
+        writeAt<std::uint32_t>(out_, dataSizeOffset_, kUnknownSize);
+    } else {
+        writeAt<std::uint32_t>(out_, 4, static_cast<std::uint32_t>(riffSize));
+        writeAt<std::uint32_t>(out_, dataSizeOffset_, static_cast<std::uint32_t>(dataBytes));
+    }
+    out_.close();
+    if (out_.fail()) {
+        throw std::runtime_error("Failed to write " + path_);
+    }
+}
+
+AudioFileReader::AudioFileReader(const std::string& path, Access access) {
+    std::uint64_t fileSize = 0;
+    if (access == Access::MemoryMap) {
+        map_.emplace(path);
+        fileSize = map_->size();
+    } else {
+        in_.open(path, std::ios::binary | std::ios::ate);
+        if (!in_) {
+            throw std::runtime_error("Failed to open " + path);
+        }
+        fileSize = static_cast<std::uint64_t>(in_.tellg());
+    }
+
+    // Bytes [offset, offset + n) of the file, or nullptr past its end. Stream
+    // reads land in one scratch buffer, valid until the next call.
+    std::vector<unsigned char> scratch;
+    const auto fetch = [&](std::uint64_t offset, std::size_t n) -> const unsigned char* {
+        if (offset > fileSize || n > fileSize - offset) {
+            return nullptr;
+        }
+        if (map_) {
+            return map_->data() + offset;
+        }
+        scratch.resize(n);
+        in_.seekg(static_cast<std::streamoff>(offset));
+        return in_.read(reinterpret_cast<char*>(scratch.data()), static_cast<std::streamsize>(n)) ? scratch.data() : nullptr;
+    };
+    const auto fail = [&path](const char* what) {
+        throw std::runtime_error("Invalid WAV " + path + ": " + what);
+    };
+
+    const unsigned char* riff = fetch(0, 12);
+    if (riff == nullptr || (std::memcmp(riff, "RIFF", 4) != 0 && std::memcmp(riff, "RF64", 4) != 0) || std::memcmp(riff + 8, "WAVE", 4) != 0) {
+        fail("not a RIFF/RF64 WAVE file");
+    }
+    const bool rf64 = std::memcmp(riff, "RF64", 4) == 0;
+
+    std::optional<std::uint64_t> ds64DataBytes;
+    bool haveFormat = false;
+    for (std::uint64_t offset = 12;;) {
+        const unsigned char* chunk = fetch(offset, 8);
+        if (chunk == nullptr) {
+            fail("no data chunk");
+        }
+        const std::uint32_t size = readU32(chunk + 4);
+        const std::uint64_t body = offset + 8;
+        if (rf64 && std::memcmp(chunk, "ds64", 4) == 0) {
+            const unsigned char* ds64 = fetch(body, 24);
+            if (ds64 == nullptr) {
+                fail("truncated ds64 chunk");
+            }
+            ds64DataBytes = readU64(ds64 + 8);
+        } else if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            const unsigned char* fmt = size >= 16 ? fetch(body, size) : nullptr;
+            if (fmt == nullptr) {
+                fail("truncated fmt chunk");
+            }
+            std::uint16_t tag = readU16(fmt);
+            const std::uint16_t channels = readU16(fmt + 2);
+            const std::uint32_t rate = readU32(fmt + 4);
+            const std::uint16_t blockAlign = readU16(fmt + 12);
+            const std::uint16_t bits = readU16(fmt + 14);
+            if (tag == kTagExtensible && size >= 26) {
+                tag = readU16(fmt + 24);
+            }
+            if (tag == kTagFloat && bits == 32) {
+                format_ = SampleFormat::Float32;
+            } else if (tag == kTagPcm && bits == 16) {
+                format_ = SampleFormat::Int16;
+            } else if (tag == kTagPcm && bits == 24) {
+                format_ = SampleFormat::Int24;
+            } else if (tag == kTagPcm && bits == 32) {
+                format_ = SampleFormat::Int32;
+            } else {
+                fail("unsupported encoding");
+            }
+            channels_ = channels;
+            frameBytes_ = channels_ * bytesPerSample(format_);
+            if (channels == 0 || rate == 0 || rate > 0x7FFFFFFFu || blockAlign != frameBytes_) {
+                fail("bad format chunk");
+            }
+            sampleRate_ = static_cast<int>(rate);
+            haveFormat = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!haveFormat) {
+                fail("data before format chunk");
+            }
+            // An unpatched or RF64 size means "to the end of the file" unless a
+            // ds64 chunk says otherwise.
+            std::uint64_t bytes = size;
+            if (size == kUnknownSize) {
+                bytes = ds64DataBytes.value_or(fileSize - body);
+            }
+            dataOffset_ = body;
+            frames_ = std::min(bytes, fileSize - body) / frameBytes_;
+            break;
+        }
+        offset = body + size + (size & 1u);
+    }
+
+    if (map_) {
+        map_->adviseSequential();
+    } else {
+        in_.seekg(static_cast<std::streamoff>(dataOffset_));
+        buffer_.resize(std::max<std::size_t>(1, kBufferBytes / frameBytes_) * frameBytes_);
+    }
+}
+
+std::size_t AudioFileReader::read(float* const* channels, std::size_t maxFrames) {
+    const auto frames = static_cast<std::size_t>(std::min<std::uint64_t>(maxFrames, framesLeft()));
+    for (std::size_t done = 0; done < frames;) {
+        const unsigned char* src = nullptr;
+        std::size_t n = frames - done;
+        if (map_) {
+            src = map_->data() + dataOffset_ + position_ * frameBytes_;
+        } else {
+            n = std::min(n, buffer_.size() / frameBytes_);
+            if (!in_.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(n * frameBytes_))) {
+                throw std::runtime_error("WAV data ended early");
+            }
+            src = buffer_.data();
+        }
+        decode(format_, src, channels_, n, channels, done);
+        done += n;
+        position_ += n;
+    }
+    return frames;
+}
+
+} // namespace verbsuite
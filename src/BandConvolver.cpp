@@ -0,0 +1,27 @@
+#include "VerbSuite/BandConvolver.h"
+
+#include <algorithm>
+
+namespace verbsuite {
+
+std::size_t BandConvolver::foldBandIR(const ConvolverBandIR& band, float* dst, std::size_t capacity) {
+    std::size_t n = 0;
+    if (band.size > 0 && capacity > 0) {
+        const std::size_t zero = std::min(band.zeroIndex, band.size - 1);
+
+        // Taps up to zeroIndex all read the newest sample in the direct path.
+        float head = 0.0f;
+        for (std::size_t k = 0; k <= zero; ++k) {
+            head += band.data[k];
+        }
+        dst[0] = head * band.gain;
+        n = std::min(capacity, band.size - zero);
+        for (std::size_t d = 1; d < n; ++d) {
+            dst[d] = band.data[d + zero] * band.gain;
+        }
+    }
+    std::fill(dst + n, dst + capacity, 0.0f);
+    return n;
+}
+
+} // namespace verbsuite
@@ -0,0 +1,100 @@
+#include "VerbSuite/BlockProfiler.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <thread>
+
+namespace verbsuite {
+
+double cycleCounterHz() {
+    static const double hz = [] {
+        const auto wallStart = std::chrono::steady_clock::now();
+        const std::uint64_t ticksStart = readCycleCounter();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const std::uint64_t ticksEnd = readCycleCounter();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+        return static_cast<double>(ticksEnd - ticksStart) / std::max(1.0e-9, seconds);
+    }();
+    return hz;
+}
+
+std::size_t BlockHistogram::bucketFor(std::uint64_t cycles) noexcept {
+    if (cycles < kSubBuckets) {
+        return static_cast<std::size_t>(cycles);
+    }
+    // Octave o holds [2^o, 2^(o+1)); its top three bits pick the step.
+    const auto octave = static_cast<std::size_t>(std::bit_width(cycles) - 1);
+    const auto step = static_cast<std::size_t>(cycles >> (octave - 3)) & (kSubBuckets - 1);
+    return (octave - 2) * kSubBuckets + step;
+}
+
+std::uint64_t BlockHistogram::bucketLowerEdge(std::size_t bucket) noexcept {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    const std::size_t octave = bucket / kSubBuckets + 2;
+    const std::size_t step = bucket % kSubBuckets;
+    return static_cast<std::uint64_t>(kSubBuckets + step) << (octave - 3);
+}
+
+std::uint64_t BlockHistogram::bucketUpperEdge(std::size_t bucket) noexcept {
+    return bucket + 1 < kBuckets ? bucketLowerEdge(bucket + 1) - 1 : std::numeric_limits<std::uint64_t>::max();
+}
+
+void BlockHistogram::add(std::uint64_t cycles) noexcept {
+    ++buckets_[bucketFor(cycles)];
+    ++count_;
+    max_ = std::max(max_, cycles);
+    sum_ += static_cast<long double>(cycles);
+}
+
+void BlockHistogram::merge(const BlockHistogram& other) noexcept {
+    for (std::size_t b = 0; b < kBuckets; ++b) {
+        buckets_[b] += other.buckets_[b];
+    }
+    count_ += other.count_;
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+}
+
+void BlockHistogram::clear() noexcept {
+    *this = {};
+}
+
+double BlockHistogram::mean() const noexcept {
+    return count_ > 0 ? static_cast<double>(sum_ / static_cast<long double>(count_)) : 0.0;
+}
+
+std::uint64_t BlockHistogram::quantile(double q) const noexcept {
+    if (count_ == 0) {
+        return 0;
+    }
+    if (q >= 1.0) {
+        return max_;
+    }
+    const auto rank = static_cast<std::uint64_t>(std::max(0.0, q) * static_cast<double>(count_ - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < kBuckets; ++b) {
+        seen += buckets_[b];
+        if (seen >= rank) {
+            return std::min(bucketUpperEdge(b), max_);
+        }
+    }
+    return max_;
+}
+
+std::uint64_t BlockHistogram::countAbove(std::uint64_t cycles) const noexcept {
+    std::uint64_t above = 0;
+    for (std::size_t b = bucketFor(cycles) + 1; b < kBuckets; ++b) {
+        above += buckets_[b];
+    }
+    return above;
+}
+
+BlockProfiler::BlockProfiler(std::size_t capacity)
+    : records_(std::bit_ceil(std::max<std::size_t>(2, capacity))),
+      mask_(records_.size() - 1) {
+}
+
+} // namespace verbsuite
@@ -0,0 +1,93 @@
+#include "VerbSuite/CVFollower.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace verbsuite {
+
+void CVFollower::prepare(double sampleRate, std::size_t maxBlockSize, std::size_t controlInterval) {
+    sampleRate_ = std::max(1.0, sampleRate);
+    controlInterval_ = std::max<std::size_t>(1, controlInterval);
+    output_.assign(std::max<std::size_t>(1, maxBlockSize), 0.0f);
+    control_.assign((output_.size() + controlInterval_ - 1) / controlInterval_, 0.0f);
+    updateCoefficients();
+    reset();
+}
+
+void CVFollower::reset() noexcept {
+    envelope_ = 0.0f;
+    held_ = 0.0f;
+    holdLeft_ = 0;
+    controlCount_ = 0;
+    peak_ = 0.0f;
+}
+
+void CVFollower::setSettings(const CVFollowerSettings& settings) noexcept {
+    if (settings == settings_) {
+        return;
+    }
+    settings_ = settings;
+    settings_.holdPeriod = std::max<std::size_t>(1, settings_.holdPeriod);
+    updateCoefficients();
+}
+
+void CVFollower::updateCoefficients() noexcept {
+    const auto alpha = [this](float seconds) {
+        return 1.0f - std::exp(-1.0f / (seconds * static_cast<float>(sampleRate_)));
+    };
+    attackAlpha_ = alpha(settings_.attackSeconds);
+    releaseAlpha_ = alpha(settings_.releaseSeconds);
+}
+
+std::span<const float> CVFollower::process(const float* left, const float* right, std::size_t numSamples) noexcept {
+    const std::size_t n = std::min(numSamples, output_.size());
+    float* out = output_.data();
+
+    if (settings_.shape == CVShape::Raw) {
+        // One branch-free pass the compiler vectorizes. The peak is taken on
+        // the bit patterns of |cv|, which order like the values and, unlike a
+        // float max, vectorize without fast-math.
+        std::uint32_t peakBits = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const float cv = std::clamp(0.5f * (left[i] + right[i]), -1.0f, 1.0f);
+            out[i] = cv;
+            peakBits = std::max(peakBits, std::bit_cast<std::uint32_t>(cv) & 0x7fffffffu);
+        }
+        peak_ = std::bit_cast<float>(peakBits);
+    } else {
+        // The envelope recurrence is serial, but only its hold points are
+        // written out; the held value fills the samples between them.
+        float peak = holdLeft_ > 0 ? held_ : 0.0f;
+        float envelope = envelope_;
+        std::size_t i = 0;
+        while (i < n) {
+            if (holdLeft_ == 0) {
+                envelope = envelopeStep(envelope, left[i], right[i]);
+                held_ = envelope;
+                peak = std::max(peak, held_);
+                out[i] = held_;
+                holdLeft_ = settings_.holdPeriod - 1;
+                ++i;
+                continue;
+            }
+            const std::size_t end = std::min(n, i + holdLeft_);
+            for (std::size_t j = i; j < end; ++j) {
+                envelope = envelopeStep(envelope, left[j], right[j]);
+            }
+            std::fill(out + i, out + end, held_);
+            holdLeft_ -= end - i;
+            i = end;
+        }
+        envelope_ = envelope;
+        peak_ = peak;
+    }
+
+    controlCount_ = (n + controlInterval_ - 1) / controlInterval_;
+    for (std::size_t k = 0; k < controlCount_; ++k) {
+        control_[k] = out[k * controlInterval_];
+    }
+    return { out, n };
+}
+
+} // namespace verbsuite
@@ -0,0 +1,22 @@
+#include "VerbSuite/ControlBlock.h"
+
+namespace verbsuite {
+
+void ControlBlock::publish(const EngineSettings& settings) noexcept {
+    slots_[backIndex_] = settings;
+    const std::uint8_t previous = middle_.exchange(static_cast<std::uint8_t>(backIndex_ | kFresh), std::memory_order_acq_rel);
+    backIndex_ = previous & kIndexMask;
+    version_.fetch_add(1, std::memory_order_release);
+}
+
+bool ControlBlock::consume(EngineSettings& settings) noexcept {
+    if ((middle_.load(std::memory_order_relaxed) & kFresh) == 0) {
+        return false;
+    }
+    const std::uint8_t previous = middle_.exchange(frontIndex_, std::memory_order_acq_rel);
+    frontIndex_ = previous & kIndexMask;
+    settings = slots_[frontIndex_];
+    return true;
+}
+
+} // namespace verbsuite
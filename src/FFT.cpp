@@ -0,0 +1,140 @@
+#include "VerbSuite/FFT.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace verbsuite {
+namespace {
+constexpr double kTwoPi = 6.28318530717958647692;
+} // namespace
+
+RealFFT::RealFFT(std::size_t size)
+    : size_(size),
+      half_(size / 2) {
+    if (size < 4 || (size & (size - 1)) != 0) {
+        throw std::invalid_argument("RealFFT size must be a power of two >= 4");
+    }
+
+    std::size_t bits = 0;
+    while ((std::size_t { 1 } << bits) < half_) {
+        ++bits;
+    }
+    bitReverse_.resize(half_);
+    for (std::size_t i = 0; i < half_; ++i) {
+        std::size_t r = 0;
+        for (std::size_t b = 0; b < bits; ++b) {
+            r |= ((i >> b) & 1u) << (bits - 1 - b);
+        }
+        bitReverse_[i] = r;
+    }
+
+    // Twiddles for the half-size complex FFT (first half_/2 entries) and the
+    // real-spectrum split step (all half_ entries), both exp(-2*pi*i*k/size)
+    // evaluated at the right stride.
+    twiddleRe_.resize(half_);
+    twiddleIm_.resize(half_);
+    for (std::size_t k = 0; k < half_; ++k) {
+        const double phase = -kTwoPi * static_cast<double>(k) / static_cast<double>(size_);
+        twiddleRe_[k] = static_cast<float>(std::cos(phase));
+        twiddleIm_[k] = static_cast<float>(std::sin(phase));
+    }
+
+    packRe_.resize(half_);
+    packIm_.resize(half_);
+    workRe_.resize(half_ + 1);
+    workIm_.resize(half_ + 1);
+}
+
+void RealFFT::complexTransform(float* re, float* im, bool inverse) const {
+    for (std::size_t i = 0; i < half_; ++i) {
+        const std::size_t j = bitReverse_[i];
+        if (j > i) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+
+    const float sign = inverse ? -1.0f : 1.0f;
+    for (std::size_t len = 2; len <= half_; len <<= 1) {
+        const std::size_t halfLen = len / 2;
+        // Half-size transform twiddle exp(-2*pi*i*k/len) == full-size table at stride 2*half_/len.
+        const std::size_t step = (2 * half_) / len;
+        for (std::size_t start = 0; start < half_; start += len) {
+            for (std::size_t k = 0; k < halfLen; ++k) {
+                const float wr = twiddleRe_[k * step];
+                const float wi = sign * twiddleIm_[k * step];
+                const std::size_t a = start + k;
+                const std::size_t b = a + halfLen;
+                const float tr = re[b] * wr - im[b] * wi;
+                const float ti = re[b] * wi + im[b] * wr;
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+}
+
+void RealFFT::forward(const float* input, float* re, float* im) {
+    // Pack even/odd samples as one half-size complex sequence.
+    for (std::size_t n = 0; n < half_; ++n) {
+        packRe_[n] = input[2 * n];
+        packIm_[n] = input[2 * n + 1];
+    }
+    complexTransform(packRe_.data(), packIm_.data(), false);
+
+    // Split into the spectra of the even and odd halves and recombine.
+    for (std::size_t k = 0; k <= half_; ++k) {
+        const std::size_t kk = k % half_;
+        const std::size_t mk = (half_ - k) % half_;
+        const float zr = packRe_[kk];
+        const float zi = packIm_[kk];
+        const float cr = packRe_[mk];
+        const float ci = -packIm_[mk];
+
+        const float evenRe = 0.5f * (zr + cr);
+        const float evenIm = 0.5f * (zi + ci);
+        // (z - conj) / (2i)
+        const float oddRe = 0.5f * (zi - ci);
+        const float oddIm = -0.5f * (zr - cr);
+
+        const float wr = k < half_ ? twiddleRe_[k] : -1.0f;
+        const float wi = k < half_ ? twiddleIm_[k] : 0.0f;
+        re[k] = evenRe + (oddRe * wr - oddIm * wi);
+        im[k] = evenIm + (oddRe * wi + oddIm * wr);
+    }
+}
+
+void RealFFT::inverse(const float* re, const float* im, float* output) {
+    // Rebuild the packed half-size spectrum from the real spectrum.
+    for (std::size_t k = 0; k < half_; ++k) {
+        const float xr = re[k];
+        const float xi = im[k];
+        const float yr = re[half_ - k];
+        const float yi = -im[half_ - k];
+
+        const float evenRe = 0.5f * (xr + yr);
+        const float evenIm = 0.5f * (xi + yi);
+        const float dr = 0.5f * (xr - yr);
+        const float di = 0.5f * (xi - yi);
+        // odd = d * conj(w)
+        const float wr = twiddleRe_[k];
+        const float wi = -twiddleIm_[k];
+        const float oddRe = dr * wr - di * wi;
+        const float oddIm = dr * wi + di * wr;
+
+        // z = even + i * odd
+        workRe_[k] = evenRe - oddIm;
+        workIm_[k] = evenIm + oddRe;
+    }
+    complexTransform(workRe_.data(), workIm_.data(), true);
+
+    const float scale = 1.0f / static_cast<float>(half_);
+    for (std::size_t n = 0; n < half_; ++n) {
+        output[2 * n] = workRe_[n] * scale;
+        output[2 * n + 1] = workIm_[n] * scale;
+    }
+}
+
+} // namespace verbsuite
@@ -0,0 +1,287 @@
+#include "VerbSuite/IRBank.h"
+
+#include "VerbSuite/MappedFile.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace verbsuite {
+namespace {
+constexpr float kPi = 3.14159265358979323846f;
+
+constexpr char kMagic[8] = { 'V', 'S', 'I', 'R', 'B', 'A', 'N', 'K' };
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kHeaderSize = 16;
+constexpr std::size_t kEntrySize = 24;
+
+double rateRatio(double sampleRate) {
+    return sampleRate / IRBank::kReferenceRate;
+}
+
+// A length or period given in reference-rate samples, at `sampleRate`.
+std::size_t scaled(std::size_t samples, double sampleRate) {
+    return std::max<std::size_t>(1, static_cast<std::size_t>(std::llround(static_cast<double>(samples) * rateRatio(sampleRate))));
+}
+
+// One-pole smoothing coefficient tuned at the reference rate, re-derived so the
+// cutoff stays put in Hz.
+float onePoleAt(float alpha, double sampleRate) {
+    const double ratio = rateRatio(sampleRate);
+    if (ratio == 1.0) {
+        return alpha;
+    }
+    return 1.0f - static_cast<float>(std::pow(1.0 - static_cast<double>(alpha), 1.0 / ratio));
+}
+
+template <typename T>
+T readField(const unsigned char* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void writeField(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+IRBank::IRBank(double sampleRate) {
+    std::vector<std::vector<float>> irs;
+    irs.reserve(kCoreCount + kWildCount);
+    // Core bank.
+    irs.push_back(generateIR(640, 0.30f, 0.30f, 0.05f, sampleRate));
+    irs.push_back(generateIR(960, 0.80f, 0.60f, 0.25f, sampleRate));
+    irs.push_back(generateIR(1408, 1.60f, 0.80f, 0.55f, sampleRate));
+    irs.push_back(generateIR(2048, 2.80f, 0.95f, 0.88f, sampleRate));
+    irs.push_back(generateMorseIR(1536, 0.40f, sampleRate));
+    irs.push_back(generateMorseIR(2048, 0.78f, sampleRate));
+    irs.push_back(generateBodyIR(1664, 1.6f, sampleRate));
+    irs.push_back(generateBodyIR(2304, 3.1f, sampleRate));
+
+    // Wild bank.
+    irs.push_back(generateIR(384, 0.10f, 0.98f, 0.98f, sampleRate));
+    irs.push_back(generateIR(3072, 5.60f, 0.25f, 0.95f, sampleRate));
+    irs.push_back(generateMorseIR(4096, 0.96f, sampleRate));
+    irs.push_back(generateBodyIR(4096, 7.2f, sampleRate));
+    irs.push_back(generateIR(819, 0.23f, 0.99f, 0.12f, sampleRate));
+    irs.push_back(generateMorseIR(1200, 0.10f, sampleRate));
+    irs.push_back(generateBodyIR(5120, 0.4f, sampleRate));
+    irs.push_back(generateIR(4608, 7.80f, 1.0f, 0.50f, sampleRate));
+
+    // Distort/scramble wild entries for stronger character. The pattern runs on
+    // reference-rate sample indices so it spans the same time at any rate.
+    const double ratio = rateRatio(sampleRate);
+    for (std::size_t b = kCoreCount; b < irs.size(); ++b) {
+        auto& ir = irs[b];
+        for (std::size_t i = 0; i < ir.size(); ++i) {
+            const auto k = static_cast<std::size_t>(static_cast<double>(i) / ratio);
+            if ((k % 17) == 0) {
+                ir[i] = -ir[i];
+            }
+            if ((k % 31) == 0) {
+                ir[i] *= 1.8f;
+            }
+            ir[i] = std::tanh(ir[i] * 2.8f);
+        }
+    }
+
+    for (auto& ir : irs) {
+        adopt(std::move(ir), sampleRate);
+    }
+}
+
+void IRBank::adopt(std::vector<float> ir, double sampleRate) {
+    // Moving the vector keeps its heap block, so spans into earlier entries
+    // survive owned_ growing.
+    owned_.push_back(std::move(ir));
+    irs_.emplace_back(owned_.back().data(), owned_.back().size());
+    rates_.push_back(sampleRate);
+}
+
+std::shared_ptr<const IRBank> IRBank::forSampleRate(double sampleRate) {
+    static std::mutex mutex;
+    static std::vector<std::pair<double, std::shared_ptr<const IRBank>>> cache;
+
+    const std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& [rate, bank] : cache) {
+        if (rate == sampleRate) {
+            return bank;
+        }
+    }
+    auto bank = std::make_shared<const IRBank>(sampleRate);
+    cache.emplace_back(sampleRate, bank);
+    return bank;
+}
+
+std::shared_ptr<const IRBank> IRBank::load(const std::string& path) {
+    static_assert(std::endian::native == std::endian::little, "IR bank files are little-endian");
+    const MappedFile file(path);
+    const auto fail = [&path](const char* what) {
+        throw std::runtime_error("Invalid IR bank " + path + ": " + what);
+    };
+
+    if (file.size() < kHeaderSize || std::memcmp(file.data(), kMagic, sizeof(kMagic)) != 0) {
+        fail("bad header");
+    }
+    if (readField<std::uint32_t>(file.data() + 8) != kVersion) {
+        fail("unsupported version");
+    }
+    const std::size_t count = readField<std::uint32_t>(file.data() + 12);
+    if (count == 0 || kHeaderSize + count * kEntrySize > file.size()) {
+        fail("truncated IR table");
+    }
+
+    std::shared_ptr<IRBank> bank(new IRBank());
+    bank->irs_.reserve(count);
+    bank->rates_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const unsigned char* entry = file.data() + kHeaderSize + i * kEntrySize;
+        const auto rate = readField<double>(entry);
+        const auto offset = readField<std::uint64_t>(entry + 8);
+        const auto length = readField<std::uint64_t>(entry + 16);
+        if (!(rate > 0.0) || !std::isfinite(rate)) {
+            fail("bad sample rate");
+        }
+        if (length == 0 || offset % alignof(float) != 0 || offset > file.size() || length > (file.size() - offset) / sizeof(float)) {
+            fail("IR payload out of bounds");
+        }
+        bank->irs_.emplace_back(reinterpret_cast<const float*>(file.data() + offset), static_cast<std::size_t>(length));
+        bank->rates_.push_back(rate);
+    }
+    bank->storage_ = file.owner();
+    return bank;
+}
+
+std::shared_ptr<const IRBank> IRBank::atSampleRate(std::shared_ptr<const IRBank> bank, double sampleRate) {
+    if (std::all_of(bank->rates_.begin(), bank->rates_.end(), [sampleRate](double rate) { return rate == sampleRate; })) {
+        return bank;
+    }
+
+    std::shared_ptr<IRBank> resampled(new IRBank());
+    resampled->owned_.reserve(bank->irs_.size());
+    for (std::size_t b = 0; b < bank->irs_.size(); ++b) {
+        const auto source = bank->irs_[b];
+        const double step = bank->rates_[b] / sampleRate;
+        if (step == 1.0) {
+            resampled->adopt(std::vector<float>(source.begin(), source.end()), sampleRate);
+            continue;
+        }
+        std::vector<float> ir(std::max<std::size_t>(1, static_cast<std::size_t>(std::llround(static_cast<double>(source.size()) / step))));
+        for (std::size_t i = 0; i < ir.size(); ++i) {
+            const double src = static_cast<double>(i) * step;
+            const std::size_t i0 = std::min(static_cast<std::size_t>(src), source.size() - 1);
+            const std::size_t i1 = std::min(i0 + 1, source.size() - 1);
+            const auto t = static_cast<float>(src - static_cast<double>(i0));
+            ir[i] = source[i0] + (source[i1] - source[i0]) * t;
+        }
+        resampled->adopt(std::move(ir), sampleRate);
+    }
+    return resampled;
+}
+
+void IRBank::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to open IR bank for writing: " + path);
+    }
+
+    out.write(kMagic, sizeof(kMagic));
+    writeField<std::uint32_t>(out, kVersion);
+    writeField<std::uint32_t>(out, static_cast<std::uint32_t>(irs_.size()));
+
+    std::size_t offset = alignUp(kHeaderSize + irs_.size() * kEntrySize, kPayloadAlignment);
+    std::vector<std::size_t> offsets;
+    offsets.reserve(irs_.size());
+    for (std::size_t b = 0; b < irs_.size(); ++b) {
+        offsets.push_back(offset);
+        writeField<double>(out, rates_[b]);
+        writeField<std::uint64_t>(out, offset);
+        writeField<std::uint64_t>(out, irs_[b].size());
+        offset = alignUp(offset + irs_[b].size() * sizeof(float), kPayloadAlignment);
+    }
+
+    static constexpr char kPadding[kPayloadAlignment] = {};
+    for (std::size_t b = 0; b < irs_.size(); ++b) {
+        const auto position = static_cast<std::size_t>(out.tellp());
+        out.write(kPadding, static_cast<std::streamsize>(offsets[b] - position));
+        out.write(reinterpret_cast<const char*>(irs_[b].data()), static_cast<std::streamsize>(irs_[b].size() * sizeof(float)));
+    }
+    if (!out) {
+        throw std::runtime_error("Failed to write IR bank: " + path);
+    }
+}
+
+std::vector<float> IRBank::generateIR(std::size_t length, float decaySeconds, float diffusion, float tone, double sampleRate) {
+    std::vector<float> ir(scaled(length, sampleRate), 0.0f);
+    std::mt19937 localRng(static_cast<uint32_t>(length * 1337 + static_cast<int>(decaySeconds * 100.0f)));
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+
+    const float sr = static_cast<float>(sampleRate);
+    const float decay = std::max(0.02f, decaySeconds);
+    const float alpha = onePoleAt(0.02f + 0.35f * tone, sampleRate);
+    float lpState = 0.0f;
+
+    for (std::size_t i = 0; i < ir.size(); ++i) {
+        const float t = static_cast<float>(i) / sr;
+        const float env = std::exp(-t / decay);
+        const float excitation = noise(localRng) * (0.25f + 0.75f * diffusion);
+        lpState += alpha * (excitation - lpState);
+        const float shimmer = std::sin(2.0f * kPi * (120.0f + 1200.0f * tone) * t) * 0.07f;
+        ir[i] = env * (lpState + shimmer);
+    }
+
+    if (!ir.empty()) {
+        ir[0] += 1.0f;
+    }
+    return ir;
+}
+
+std::vector<float> IRBank::generateMorseIR(std::size_t length, float density, double sampleRate) {
+    std::vector<float> ir(scaled(length, sampleRate), 0.0f);
+    const std::size_t step = scaled(static_cast<std::size_t>(std::max(6, static_cast<int>(64.0f - density * 52.0f))), sampleRate);
+    const float sr = static_cast<float>(sampleRate);
+    for (std::size_t i = 0; i < ir.size(); ++i) {
+        const float env = std::exp(-static_cast<float>(i) / static_cast<float>(ir.size()) * 4.0f);
+        const bool gate = ((i / step) % 5) < 2;
+        const float tone = std::sin(2.0f * kPi * (330.0f + 90.0f * density) * static_cast<float>(i) / sr);
+        ir[i] = (gate ? 0.65f : -0.18f) * env * tone;
+    }
+    if (!ir.empty()) {
+        ir[0] += 0.9f;
+    }
+    return ir;
+}
+
+std::vector<float> IRBank::generateBodyIR(std::size_t length, float pulseHz, double sampleRate) {
+    std::vector<float> ir(scaled(length, sampleRate), 0.0f);
+    const float sr = static_cast<float>(sampleRate);
+    const float clickPeriod = static_cast<float>(347.0 * rateRatio(sampleRate));
+    const float clickWidth = static_cast<float>(4.0 * rateRatio(sampleRate));
+    for (std::size_t i = 0; i < ir.size(); ++i) {
+        const float t = static_cast<float>(i) / sr;
+        const float breath = std::max(0.0f, std::sin(2.0f * kPi * pulseHz * t));
+        const float click = (std::fmod(static_cast<float>(i), clickPeriod) < clickWidth) ? 0.6f : 0.0f;
+        const float env = std::exp(-t * 2.2f);
+        ir[i] = env * (0.45f * breath + click);
+    }
+    if (!ir.empty()) {
+        ir[0] += 0.55f;
+    }
+    return ir;
+}
+
+} // namespace verbsuite
@@ -0,0 +1,126 @@
+#include "VerbSuite/IRSynthesisPool.h"
+
+#include "VerbSuite/IRSynthesisWorker.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace verbsuite {
+
+IRSynthesisPool::IRSynthesisPool(std::size_t threads) {
+    if (threads == 0) {
+        const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        threads = std::max<std::size_t>(1, cores - 1);
+    }
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this, i] { run(i); });
+    }
+}
+
+IRSynthesisPool::~IRSynthesisPool() {
+    stopping_.store(true, std::memory_order_release);
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+IRSynthesisPool& IRSynthesisPool::shared() {
+    // Never destroyed, so engines torn down during static destruction can still
+    // detach from it.
+    static IRSynthesisPool* pool = new IRSynthesisPool();
+    return *pool;
+}
+
+IRSynthesisPool::Stats IRSynthesisPool::stats() const noexcept {
+    Stats stats;
+    stats.jobs = jobs_.load(std::memory_order_relaxed);
+    stats.late = late_.load(std::memory_order_relaxed);
+    stats.stolen = stolen_.load(std::memory_order_relaxed);
+    stats.busySeconds = static_cast<double>(busyNanoseconds_.load(std::memory_order_relaxed)) * 1.0e-9;
+    return stats;
+}
+
+void IRSynthesisPool::attach(IRSynthesisWorker* worker) {
+    const std::lock_guard<std::mutex> lock(registryMutex_);
+    const auto free = std::find(workers_.begin(), workers_.end(), nullptr);
+    if (free != workers_.end()) {
+        *free = worker;
+    } else {
+        workers_.push_back(worker);
+    }
+}
+
+void IRSynthesisPool::detach(IRSynthesisWorker* worker) {
+    {
+        // Claims happen under this lock, so once the worker is out of the
+        // registry nothing new can start on it.
+        const std::lock_guard<std::mutex> lock(registryMutex_);
+        std::replace(workers_.begin(), workers_.end(), worker, static_cast<IRSynthesisWorker*>(nullptr));
+    }
+    while (worker->requestState_.load(std::memory_order_acquire) == IRSynthesisWorker::kRunning) {
+        worker->requestState_.wait(IRSynthesisWorker::kRunning, std::memory_order_acquire);
+    }
+}
+
+void IRSynthesisPool::wake() noexcept {
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_one();
+}
+
+IRSynthesisWorker* IRSynthesisPool::claim(std::size_t index, bool& stolen) {
+    const std::lock_guard<std::mutex> lock(registryMutex_);
+    const std::size_t threads = threads_.size();
+    // Only the audio threads race us here (by taking a pending request back to
+    // replace it), so a few rescans always settle.
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        IRSynthesisWorker* best = nullptr;
+        bool bestHome = false;
+        auto bestDeadline = std::numeric_limits<Clock::rep>::max();
+        for (std::size_t slot = 0; slot < workers_.size(); ++slot) {
+            IRSynthesisWorker* worker = workers_[slot];
+            if (worker == nullptr || worker->requestState_.load(std::memory_order_acquire) != IRSynthesisWorker::kPending) {
+                continue;
+            }
+            const bool home = slot % threads == index;
+            const auto deadline = worker->deadline_.load(std::memory_order_relaxed);
+            if (best == nullptr || (home && !bestHome) || (home == bestHome && deadline < bestDeadline)) {
+                best = worker;
+                bestHome = home;
+                bestDeadline = deadline;
+            }
+        }
+        if (best == nullptr) {
+            return nullptr;
+        }
+        if (best->tryClaim()) {
+            stolen = !bestHome;
+            return best;
+        }
+    }
+    return nullptr;
+}
+
+void IRSynthesisPool::run(std::size_t index) {
+    while (!stopping_.load(std::memory_order_acquire)) {
+        // Read before scanning, so a wake() that lands mid-scan isn't lost.
+        const std::uint32_t seen = signal_.load(std::memory_order_acquire);
+        bool stolen = false;
+        if (IRSynthesisWorker* worker = claim(index, stolen)) {
+            const Clock::rep deadline = worker->deadline_.load(std::memory_order_relaxed);
+            const auto start = Clock::now();
+            worker->runClaimed();
+            const auto end = Clock::now();
+            jobs_.fetch_add(1, std::memory_order_relaxed);
+            stolen_.fetch_add(stolen ? 1 : 0, std::memory_order_relaxed);
+            late_.fetch_add(deadline != 0 && end.time_since_epoch().count() > deadline ? 1 : 0, std::memory_order_relaxed);
+            busyNanoseconds_.fetch_add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()), std::memory_order_relaxed);
+            continue;
+        }
+        signal_.wait(seen, std::memory_order_acquire);
+    }
+}
+
+} // namespace verbsuite
@@ -0,0 +1,128 @@
+#include "VerbSuite/IRSynthesisWorker.h"
+
+#include <algorithm>
+
+namespace verbsuite {
+
+IRSynthesisWorker::IRSynthesisWorker(const std::vector<std::span<const float>>& bank, std::size_t irCapacity, std::size_t feedbackSize, const RandomStream& rng, IRSynthesisPool* pool)
+    : synth_(bank),
+      rng_(rng),
+      requestFeedback_(feedbackSize, 0.0f),
+      pool_(pool) {
+    synth_.prepare(irCapacity);
+    for (auto& slot : slots_) {
+        slot.prepare(irCapacity);
+    }
+    requestFeedbackView_ = { requestFeedback_.data(), requestFeedback_.size(), 0 };
+    if (pool_ != nullptr) {
+        pool_->attach(this);
+    } else {
+        thread_ = std::thread([this] { run(); });
+    }
+}
+
+IRSynthesisWorker::~IRSynthesisWorker() {
+    if (pool_ != nullptr) {
+        pool_->detach(this);
+        return;
+    }
+    requestState_.store(kStopping, std::memory_order_release);
+    requestState_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool IRSynthesisWorker::learnsFromFeedback(WeirdMode mode) {
+    return mode == WeirdMode::HabitRoom || mode == WeirdMode::RainforestMemory;
+}
+
+bool IRSynthesisWorker::submit(const LivingIRSnapshot& state, const FeedbackView& feedback, IRSynthesisPool::Clock::time_point deadline) {
+    std::uint32_t current = requestState_.load(std::memory_order_acquire);
+    if (current == kPending) {
+        // Nobody has started the previous request; this one is fresher. Losing
+        // the race means a thread just claimed it.
+        if (!requestState_.compare_exchange_strong(current, kIdle, std::memory_order_acq_rel)) {
+            return false;
+        }
+    } else if (current != kIdle) {
+        return false;
+    }
+
+    request_ = state;
+    if (learnsFromFeedback(state.mode)) {
+        const std::size_t n = std::min(feedback.size, requestFeedback_.size());
+        std::copy(feedback.data, feedback.data + n, requestFeedback_.begin());
+        requestFeedbackView_.size = n;
+        requestFeedbackView_.write = feedback.write;
+    }
+    deadline_.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+
+    requestState_.store(kPending, std::memory_order_release);
+    if (pool_ != nullptr) {
+        pool_->wake();
+    } else {
+        requestState_.notify_one();
+    }
+    return true;
+}
+
+bool IRSynthesisWorker::collect(LivingIRSet& active) {
+    if ((middle_.load(std::memory_order_relaxed) & kFresh) == 0) {
+        return false;
+    }
+
+    const std::uint8_t previous = middle_.exchange(frontIndex_, std::memory_order_acq_rel);
+    frontIndex_ = previous & kIndexMask;
+
+    auto& fresh = slots_[frontIndex_];
+    active.low.swap(fresh.low);
+    active.mid.swap(fresh.mid);
+    active.high.swap(fresh.high);
+    active.zeroIndex = fresh.zeroIndex;
+    active.events = fresh.events;
+    return true;
+}
+
+void IRSynthesisWorker::reset(const RandomStream& rng) {
+    // Drop a request nobody has started, then wait out one that is running.
+    std::uint32_t expected = kPending;
+    requestState_.compare_exchange_strong(expected, kIdle, std::memory_order_acq_rel);
+    while (requestState_.load(std::memory_order_acquire) == kRunning) {
+        requestState_.wait(kRunning, std::memory_order_acquire);
+    }
+    middle_.fetch_and(kIndexMask, std::memory_order_acq_rel);
+    rng_ = rng;
+}
+
+bool IRSynthesisWorker::tryClaim() noexcept {
+    std::uint32_t expected = kPending;
+    return requestState_.compare_exchange_strong(expected, kRunning, std::memory_order_acq_rel);
+}
+
+void IRSynthesisWorker::runClaimed() {
+    synth_.run(request_, requestFeedbackView_, rng_, slots_[backIndex_]);
+
+    const std::uint8_t previous = middle_.exchange(static_cast<std::uint8_t>(backIndex_ | kFresh), std::memory_order_acq_rel);
+    backIndex_ = previous & kIndexMask;
+
+    // A failed exchange means the destructor asked us to stop mid-job.
+    std::uint32_t expected = kRunning;
+    requestState_.compare_exchange_strong(expected, kIdle, std::memory_order_acq_rel);
+    requestState_.notify_all();
+}
+
+void IRSynthesisWorker::run() {
+    for (;;) {
+        requestState_.wait(kIdle, std::memory_order_acquire);
+        if (requestState_.load(std::memory_order_acquire) == kStopping) {
+            return;
+        }
+        // Fails when the audio thread took the request back to replace it.
+        if (tryClaim()) {
+            runClaimed();
+        }
+    }
+}
+
+} // namespace verbsuite
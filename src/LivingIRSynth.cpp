@@ -0,0 +1,476 @@
+#include "VerbSuite/LivingIRSynth.h"
+
+#include "VerbSuite/BlockProfiler.h"
+#include "VerbSuite/FastMath.h"
+#include "VerbSuite/WeirdConvolutionReverb.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace verbsuite {
+namespace {
+constexpr float kPi = 3.14159265358979323846f;
+
+float softClip(float x) {
+    return dspTanh(x);
+}
+
+float clamp01(float x) {
+    return std::clamp(x, 0.0f, 1.0f);
+}
+
+constexpr std::size_t kBankCount = 8;
+
+} // namespace
+
+void LivingIRSet::prepare(std::size_t capacity) {
+    low.reserve(capacity);
+    mid.reserve(capacity);
+    high.reserve(capacity);
+}
+
+void IRWorkspace::prepare(std::size_t capacity) {
+    baseA.reserve(capacity);
+    baseB.reserve(capacity);
+    scratch.reserve(capacity);
+    uniforms.reserve(capacity);
+}
+
+void IRWorkspace::release() {
+    for (auto* buffer : { &baseA, &baseB, &scratch, &uniforms }) {
+        std::vector<float>().swap(*buffer);
+    }
+}
+
+// Same order as the original all-at-once pipeline: morph the bases and bands,
+// stretch each band, modulate each band, misalign mid and high, then the
+// whole-set causality, learning and stale-band steps.
+const std::array<LivingIRSynth::PassStep, 24> LivingIRSynth::kSchedule = {{
+    { Pass::MorphBaseA, 0 },
+    { Pass::MorphBaseB, 0 },
+    { Pass::MorphMid, 1 },
+    { Pass::MorphLow, 0 },
+    { Pass::MorphHigh, 2 },
+    { Pass::Stretch, 0 },
+    { Pass::Stretch, 1 },
+    { Pass::Stretch, 2 },
+    { Pass::Resample, 0 },
+    { Pass::Grains, 0 },
+    { Pass::Quantize, 0 },
+    { Pass::Resample, 1 },
+    { Pass::Grains, 1 },
+    { Pass::Quantize, 1 },
+    { Pass::Resample, 2 },
+    { Pass::Grains, 2 },
+    { Pass::Quantize, 2 },
+    { Pass::Rotate, 1 },
+    { Pass::Flip, 1 },
+    { Pass::Rotate, 2 },
+    { Pass::Flip, 2 },
+    { Pass::Causality, 0 },
+    { Pass::Learn, 1 },
+    { Pass::StaleBand, 0 },
+}};
+
+LivingIRSynth::LivingIRSynth(const std::vector<std::span<const float>>& bank)
+    : bank_(&bank) {
+}
+
+std::size_t LivingIRSynth::capacityFor(const std::vector<std::span<const float>>& bank) {
+    // Longest bank entry at full breathing stretch, so the ping-pong swaps in
+    // run() never reallocate.
+    std::size_t longest = 0;
+    for (const auto& ir : bank) {
+        longest = std::max(longest, ir.size());
+    }
+    return static_cast<std::size_t>(std::ceil(static_cast<float>(longest) * kMaxBreathStretch)) + 1;
+}
+
+void LivingIRSynth::prepare(std::size_t irCapacity) {
+    workspace_.prepare(irCapacity);
+}
+
+void LivingIRSynth::release() {
+    cancel();
+    workspace_.release();
+}
+
+void LivingIRSynth::morphIR(std::span<const float> a, std::span<const float> b, float t, std::vector<float>& out) {
+    const std::size_t n = std::max(a.size(), b.size());
+    out.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const float av = i < a.size() ? a[i] : 0.0f;
+        const float bv = i < b.size() ? b[i] : 0.0f;
+        out[i] = av + (bv - av) * t;
+    }
+}
+
+void LivingIRSynth::run(const LivingIRSnapshot& state, const FeedbackView& feedback, RandomStream& rng, LivingIRSet& out) {
+    begin(state, feedback, out);
+    step(std::numeric_limits<std::size_t>::max(), rng);
+}
+
+void LivingIRSynth::begin(const LivingIRSnapshot& state, const FeedbackView& feedback, LivingIRSet& out) {
+    out_ = &out;
+    state_ = state;
+    feedback_ = feedback;
+    schedulePos_ = 0;
+    passOpen_ = false;
+    cursor_ = 0;
+    passEnd_ = 0;
+    workDone_ = 0;
+    out.events = 0;
+
+    const WeirdControls& controls = state.controls;
+    const WeirdMode mode = state.mode;
+    const float instability = 1.0f - state.dynamicStability;
+    indexA_ = clamp01(state.featureEnvelope * 5.0f + controls.entropy * 0.35f + instability * 0.2f);
+    indexB_ = clamp01(state.featureBrightness * 7.5f + controls.memory * 0.25f);
+    bankStart_ = controls.wildIrBank ? 8u : 0u;
+
+    const float modeSkew = static_cast<float>(static_cast<int>(mode)) / static_cast<float>(WeirdConvolutionReverb::modeCount() - 1);
+    morph_ = 0.5f + 0.48f * std::sin(static_cast<float>(state.frameCounter) * (0.0007f + modeSkew * 0.0005f));
+
+    // Elastic time.
+    breathing_ = 1.0f;
+    float breathHz = std::max(0.01f, controls.breathRateHz);
+    if (controls.tempoSync) {
+        const float beats = std::max(0.0625f, controls.breathBeats);
+        const float beatHz = std::max(30.0f, controls.bpm) / 60.0f;
+        breathHz = beatHz / beats;
+    }
+    if (mode == WeirdMode::LivingSignal || mode == WeirdMode::Afterimage || mode == WeirdMode::HabitRoom || mode == WeirdMode::UncannyCausality) {
+        const float phase = 2.0f * kPi * breathHz * (static_cast<float>(state.frameCounter) / static_cast<float>(state.sampleRate));
+        const float lfo = 0.5f + 0.5f * std::sin(phase * (0.8f + instability * 1.8f));
+        breathing_ = 1.0f + (lfo * 2.0f - 1.0f) * (0.65f + 0.95f * controls.breathDepth);
+        breathing_ = std::clamp(breathing_, 0.35f, kMaxBreathStretch);
+    }
+
+    // Modulation.
+    const float lfo = std::sin(static_cast<float>(state.frameCounter) * (0.00028f + 0.0004f * controls.entropy));
+    microSpeed_ = 1.0f + lfo * (0.08f + 0.23f * instability);
+    grainStep_ = std::max<std::size_t>(4, static_cast<std::size_t>(18 - controls.entropy * 12.0f));
+    jitterRange_ = 18.0f + controls.entropy * 24.0f;
+    const int bits = static_cast<int>(2 + controls.coherence * 10.0f + state.dynamicStability * 4.0f);
+    quantizeScale_ = static_cast<float>(1 << bits);
+    quantizeHold_ = static_cast<std::size_t>(1 + static_cast<int>(controls.entropy * 9.0f + instability * 4.0f));
+    drive_ = 1.1f + 4.0f * controls.memory + 3.0f * instability;
+
+    // Spectral misalignment.
+    misalign_ = mode == WeirdMode::SpectralGhost || mode == WeirdMode::ProcessImprint || mode == WeirdMode::Afterimage || controls.coherence < 0.6f;
+    const float rot = 0.03f + 0.9f * (1.0f - controls.coherence) + 0.5f * instability;
+    cosRot_ = std::cos(rot);
+    sinRot_ = std::sin(rot);
+    flipChance_ = controls.entropy * (0.2f + 0.5f * instability);
+
+    learnRate_ = 0.00005f + 0.005f * instability;
+    workTotal_ = predictWork();
+}
+
+bool LivingIRSynth::step(std::size_t budget, RandomStream& rng) {
+    std::size_t done = 0;
+    while (out_ != nullptr) {
+        if (!passOpen_) {
+            openPass(rng);
+            passOpen_ = true;
+        }
+        if (cursor_ < passEnd_) {
+            if (done >= budget) {
+                return false;
+            }
+            const std::size_t end = cursor_ + std::min(passEnd_ - cursor_, budget - done);
+            runPass(cursor_, end);
+            done += end - cursor_;
+            workDone_ += end - cursor_;
+            cursor_ = end;
+            if (cursor_ < passEnd_) {
+                return false;
+            }
+        }
+        closePass(rng);
+        passOpen_ = false;
+        if (++schedulePos_ == kSchedule.size()) {
+            out_ = nullptr;
+        }
+    }
+    return true;
+}
+
+std::vector<float>& LivingIRSynth::band(std::uint8_t index) const noexcept {
+    return index == 0 ? out_->low : (index == 1 ? out_->mid : out_->high);
+}
+
+std::size_t LivingIRSynth::predictWork() const {
+    const auto& bank = *bank_;
+    const auto morphSize = [&](float index) {
+        const std::size_t i0 = static_cast<std::size_t>(index * static_cast<float>(kBankCount - 1));
+        const std::size_t i1 = std::min(i0 + 1, kBankCount - 1);
+        return std::max(bank[bankStart_ + i0].size(), bank[bankStart_ + i1].size());
+    };
+    const std::size_t baseA = morphSize(indexA_);
+    const std::size_t baseB = morphSize(indexB_);
+    const std::size_t morphed[] = {
+        std::max(baseA, bank[bankStart_].size()),
+        std::max(baseA, baseB),
+        std::max(baseB, bank[bankStart_ + kBankCount - 1].size()),
+    };
+    std::size_t work = baseA + baseB + morphed[0] + morphed[1] + morphed[2];
+
+    std::size_t sizes[3] = {};
+    for (std::size_t b = 0; b < 3; ++b) {
+        const std::size_t n = morphed[b] == 0 ? 0 : std::max<std::size_t>(128, static_cast<std::size_t>(static_cast<float>(morphed[b]) * breathing_));
+        sizes[b] = n;
+        work += n + n + (n > 0 ? (n - 1) / grainStep_ : 0) + n;
+        if (b > 0 && misalign_ && n >= 4) {
+            work += n - 2 + (n + 7) / 8;
+        }
+    }
+    if (state_.mode == WeirdMode::UncannyCausality || 1.0f - state_.dynamicStability > 0.6f) {
+        work += std::max<std::size_t>(16, sizes[1] / 5) / 2;
+    }
+    if (state_.mode == WeirdMode::HabitRoom || state_.mode == WeirdMode::RainforestMemory) {
+        work += sizes[1];
+    }
+    return work;
+}
+
+void LivingIRSynth::openPass(RandomStream& rng) {
+    const PassStep current = kSchedule[schedulePos_];
+    const auto& bank = *bank_;
+    cursor_ = 0;
+    passEnd_ = 0;
+    target_ = &band(current.band);
+
+    switch (current.pass) {
+    case Pass::MorphBaseA:
+    case Pass::MorphBaseB: {
+        const float pos = (current.pass == Pass::MorphBaseA ? indexA_ : indexB_) * static_cast<float>(kBankCount - 1);
+        const std::size_t i0 = static_cast<std::size_t>(pos);
+        const std::size_t i1 = std::min(i0 + 1, kBankCount - 1);
+        morphA_ = bank[bankStart_ + i0];
+        morphB_ = bank[bankStart_ + i1];
+        morphT_ = pos - static_cast<float>(i0);
+        target_ = current.pass == Pass::MorphBaseA ? &workspace_.baseA : &workspace_.baseB;
+        break;
+    }
+    case Pass::MorphMid:
+        morphA_ = workspace_.baseA;
+        morphB_ = workspace_.baseB;
+        morphT_ = morph_;
+        break;
+    case Pass::MorphLow:
+        morphA_ = workspace_.baseA;
+        morphB_ = bank[bankStart_];
+        morphT_ = 0.4f + 0.5f * state_.controls.memory;
+        break;
+    case Pass::MorphHigh:
+        morphA_ = workspace_.baseB;
+        morphB_ = bank[bankStart_ + kBankCount - 1];
+        morphT_ = 0.45f + 0.45f * state_.controls.entropy;
+        break;
+    case Pass::Stretch:
+        if (!target_->empty()) {
+            passEnd_ = std::max<std::size_t>(128, static_cast<std::size_t>(static_cast<float>(target_->size()) * breathing_));
+            workspace_.scratch.resize(passEnd_);
+        }
+        return;
+    case Pass::Resample:
+        passEnd_ = target_->size();
+        workspace_.scratch.resize(passEnd_);
+        return;
+    case Pass::Grains:
+        if (!target_->empty()) {
+            auto& draws = workspace_.uniforms;
+            draws.resize((target_->size() - 1) / grainStep_);
+            rng.fill(draws.data(), draws.size());
+            passEnd_ = draws.size();
+        }
+        return;
+    case Pass::Quantize:
+        passEnd_ = target_->size();
+        return;
+    case Pass::Rotate:
+        passEnd_ = misalign_ && target_->size() >= 4 ? target_->size() - 2 : 0;
+        return;
+    case Pass::Flip:
+        if (misalign_ && target_->size() >= 4) {
+            auto& draws = workspace_.uniforms;
+            draws.resize((target_->size() + 7) / 8);
+            rng.fill(draws.data(), draws.size());
+            passEnd_ = draws.size();
+        }
+        return;
+    case Pass::Causality:
+        reverseSpan_ = 0;
+        if (state_.mode == WeirdMode::UncannyCausality || 1.0f - state_.dynamicStability > 0.6f) {
+            out_->zeroIndex = std::min<std::size_t>(out_->mid.size() / 2, 256);
+            reverseSpan_ = std::max<std::size_t>(16, out_->mid.size() / 5);
+            passEnd_ = reverseSpan_ / 2;
+        } else {
+            out_->zeroIndex = 0;
+        }
+        return;
+    case Pass::Learn:
+        if (state_.mode == WeirdMode::HabitRoom || state_.mode == WeirdMode::RainforestMemory) {
+            passEnd_ = out_->mid.size();
+        }
+        return;
+    case Pass::StaleBand:
+        return;
+    }
+
+    // The morph passes.
+    passEnd_ = std::max(morphA_.size(), morphB_.size());
+    target_->resize(passEnd_);
+}
+
+void LivingIRSynth::runPass(std::size_t begin, std::size_t end) {
+    auto& ir = *target_;
+    switch (kSchedule[schedulePos_].pass) {
+    case Pass::MorphBaseA:
+    case Pass::MorphBaseB:
+    case Pass::MorphMid:
+    case Pass::MorphLow:
+    case Pass::MorphHigh:
+        for (std::size_t i = begin; i < end; ++i) {
+            const float av = i < morphA_.size() ? morphA_[i] : 0.0f;
+            const float bv = i < morphB_.size() ? morphB_[i] : 0.0f;
+            ir[i] = av + (bv - av) * morphT_;
+        }
+        break;
+    case Pass::Stretch: {
+        auto& stretched = workspace_.scratch;
+        for (std::size_t i = begin; i < end; ++i) {
+            const float src = static_cast<float>(i) / std::max(0.001f, breathing_);
+            const std::size_t i0 = std::min<std::size_t>(static_cast<std::size_t>(src), ir.size() - 1);
+            const std::size_t i1 = std::min<std::size_t>(i0 + 1, ir.size() - 1);
+            const float t = src - static_cast<float>(i0);
+            stretched[i] = ir[i0] + (ir[i1] - ir[i0]) * t;
+        }
+        break;
+    }
+    case Pass::Resample: {
+        auto& resampled = workspace_.scratch;
+        for (std::size_t i = begin; i < end; ++i) {
+            const float src = static_cast<float>(i) * microSpeed_;
+            const std::size_t i0 = static_cast<std::size_t>(src);
+            const std::size_t i1 = std::min(i0 + 1, ir.size() - 1);
+            const float t = src - static_cast<float>(i0);
+            const float a = i0 < ir.size() ? ir[i0] : 0.0f;
+            const float b = i1 < ir.size() ? ir[i1] : 0.0f;
+            resampled[i] = a + (b - a) * t;
+        }
+        break;
+    }
+    case Pass::Grains: {
+        const auto& draws = workspace_.uniforms;
+        for (std::size_t g = begin; g < end; ++g) {
+            const std::size_t i = (g + 1) * grainStep_;
+            const std::size_t jitter = static_cast<std::size_t>(draws[g] * jitterRange_);
+            const std::size_t j = std::min(ir.size() - 1, i + jitter);
+            std::swap(ir[i], ir[j]);
+        }
+        break;
+    }
+    case Pass::Quantize:
+        // Held taps copy an earlier tap that has already been through the
+        // quantizer, so this pass must run front to back.
+        for (std::size_t i = begin; i < end; ++i) {
+            if ((i % quantizeHold_) != 0) {
+                ir[i] = ir[i - (i % quantizeHold_)];
+            }
+            ir[i] = std::round(ir[i] * quantizeScale_) / quantizeScale_;
+            ir[i] = softClip(ir[i] * drive_);
+        }
+        break;
+    case Pass::Rotate:
+        for (std::size_t i = begin + 2; i < end + 2; ++i) {
+            const float a = ir[i];
+            const float b = ir[i - 1];
+            ir[i] = a * cosRot_ - b * sinRot_;
+        }
+        break;
+    case Pass::Flip: {
+        const auto& draws = workspace_.uniforms;
+        for (std::size_t k = begin; k < end; ++k) {
+            if (draws[k] < flipChance_) {
+                ir[k * 8] = -ir[k * 8];
+            }
+        }
+        break;
+    }
+    case Pass::Causality: {
+        auto& mid = out_->mid;
+        for (std::size_t k = begin; k < end; ++k) {
+            std::swap(mid[k], mid[reverseSpan_ - 1 - k]);
+        }
+        break;
+    }
+    case Pass::Learn: {
+        auto& mid = out_->mid;
+        for (std::size_t i = begin; i < end; ++i) {
+            const float h = feedback_.data[(feedback_.write + feedback_.size - i - 1) % feedback_.size];
+            mid[i] += h * learnRate_;
+        }
+        break;
+    }
+    case Pass::StaleBand:
+        break;
+    }
+}
+
+void LivingIRSynth::closePass(RandomStream& rng) {
+    auto& ir = *target_;
+    switch (kSchedule[schedulePos_].pass) {
+    case Pass::Stretch: {
+        if (ir.empty()) {
+            break;
+        }
+        auto& stretched = workspace_.scratch;
+        const WeirdMode mode = state_.mode;
+        if ((mode == WeirdMode::Afterimage || mode == WeirdMode::SpectralGhost) && (state_.frameCounter % 5 == 0)) {
+            const std::size_t start = static_cast<std::size_t>(rng.uniform(0.0f, static_cast<float>(stretched.size() * 0.70f)));
+            const std::size_t len = std::min<std::size_t>(96, stretched.size() - start);
+            float hold = 0.0f;
+            for (std::size_t i = 0; i < len; ++i) {
+                hold = 0.985f * hold + 0.015f * stretched[start + i];
+                stretched[start + i] = hold;
+            }
+        }
+        ir.swap(stretched);
+        break;
+    }
+    case Pass::Resample:
+        if (!ir.empty()) {
+            ir.swap(workspace_.scratch);
+        }
+        break;
+    case Pass::Causality:
+        if (reverseSpan_ > 0) {
+            auto& low = out_->low;
+            if (!low.empty()) {
+                std::reverse(low.begin(), low.begin() + std::min<std::size_t>(low.size(), 48));
+            }
+            out_->events |= blockEventBit(BlockEvent::Reversal);
+        }
+        break;
+    case Pass::StaleBand: {
+        auto& out = *out_;
+        if (state_.mode == WeirdMode::DigitalFailure && rng.uniform() < state_.controls.entropy * 0.28f) {
+            // Blockwise broken update: leave one band stale.
+            out.events |= blockEventBit(BlockEvent::StaleBand);
+            if (rng.uniform() < 0.5f) {
+                out.low.assign(out.mid.begin(), out.mid.begin() + std::min(out.mid.size(), out.low.size()));
+            } else {
+                out.high.assign(out.mid.begin(), out.mid.begin() + std::min(out.mid.size(), out.high.size()));
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+} // namespace verbsuite
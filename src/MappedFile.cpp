@@ -0,0 +1,61 @@
+#include "VerbSuite/MappedFile.h"
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace verbsuite {
+
+MappedFile::MappedFile(const std::string& path) {
+#if !defined(_WIN32)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to read " + path);
+    }
+    const auto size = static_cast<std::size_t>(info.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Failed to map " + path);
+    }
+    owner_ = std::shared_ptr<const void>(mapped, [size](const void* p) { ::munmap(const_cast<void*>(p), size); });
+    data_ = static_cast<const unsigned char*>(mapped);
+    size_ = size;
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Failed to open " + path);
+    }
+    const auto size = static_cast<std::size_t>(in.tellg());
+    auto blob = std::make_shared<std::vector<std::uint64_t>>((size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+    in.seekg(0);
+    if (size == 0 || !in.read(reinterpret_cast<char*>(blob->data()), static_cast<std::streamsize>(size))) {
+        throw std::runtime_error("Failed to read " + path);
+    }
+    data_ = reinterpret_cast<const unsigned char*>(blob->data());
+    size_ = size;
+    owner_ = std::move(blob);
+#endif
+}
+
+void MappedFile::adviseSequential() const noexcept {
+#if !defined(_WIN32)
+    ::madvise(const_cast<unsigned char*>(data_), size_, MADV_SEQUENTIAL);
+#endif
+}
+
+} // namespace verbsuite
@@ -0,0 +1,423 @@
+#include "VerbSuite/NonUniformConvolver.h"
+
+#include <algorithm>
+
+namespace verbsuite {
+namespace {
+constexpr std::size_t kMaxPartitionSize = 1024;
+// Same spectral lag budget as the uniform engine: a full set of new IR spectra
+// is built over roughly this many samples.
+constexpr std::size_t kTransformSpanSamples = 2048;
+} // namespace
+
+struct NonUniformConvolver::Segment {
+    Segment(std::size_t partitionSizeIn, std::size_t offsetIn, std::size_t numPartitionsIn)
+        : partitionSize(partitionSizeIn),
+          offset(offsetIn),
+          numPartitions(numPartitionsIn),
+          numBins(partitionSizeIn + 1),
+          fft(partitionSizeIn * 2),
+          inputBlock(partitionSizeIn * 2, 0.0f),
+          pendingInput(partitionSizeIn * 2, 0.0f),
+          fdlRe(numPartitionsIn * numBins, 0.0f),
+          fdlIm(numPartitionsIn * numBins, 0.0f),
+          accRe(kBands * numBins, 0.0f),
+          accIm(kBands * numBins, 0.0f),
+          crossRe(kBands * numBins, 0.0f),
+          crossIm(kBands * numBins, 0.0f),
+          timeScratch(partitionSizeIn * 2, 0.0f),
+          crossScratch(partitionSizeIn * 2, 0.0f) {
+        for (std::size_t set = 0; set < 2; ++set) {
+            filterRe[set].assign(kBands * numPartitions * numBins, 0.0f);
+            filterIm[set].assign(kBands * numPartitions * numBins, 0.0f);
+        }
+    }
+
+    [[nodiscard]] std::size_t filterOffset(std::size_t band, std::size_t partition) const noexcept {
+        return (band * numPartitions + partition) * numBins;
+    }
+
+    std::size_t partitionSize;
+    std::size_t offset;
+    std::size_t numPartitions;
+    std::size_t numBins;
+    RealFFT fft;
+
+    std::vector<float> inputBlock;
+    std::vector<float> pendingInput;
+    std::size_t inputPos = 0;
+
+    std::vector<float> fdlRe;
+    std::vector<float> fdlIm;
+    std::size_t fdlHead = 0;
+
+    std::array<std::vector<float>, 2> filterRe;
+    std::array<std::vector<float>, 2> filterIm;
+    std::array<std::array<std::size_t, kBands>, 2> bandPartitions {};
+    std::size_t activeFilter = 0;
+    std::size_t firstTransformItem = 0;
+    bool switchPending = false;
+
+    // Block currently being computed: FFT, then one MAC item per (band,
+    // partition), then one IFFT item per band.
+    enum class Stage : std::uint8_t { Forward, Accumulate, Inverse, Done };
+    bool inFlight = false;
+    bool crossfade = false;
+    Stage stage = Stage::Done;
+    std::size_t cursorBand = 0;
+    std::size_t cursorPartition = 0;
+    std::array<std::size_t, kBands> blockPartitions {};
+    std::size_t blockTime = 0;
+    std::size_t samplesSinceStart = 0;
+    std::size_t workTotal = 0;
+    std::size_t workDone = 0;
+
+    std::vector<float> accRe;
+    std::vector<float> accIm;
+    std::vector<float> crossRe;
+    std::vector<float> crossIm;
+    std::vector<float> timeScratch;
+    std::vector<float> crossScratch;
+};
+
+NonUniformConvolver::NonUniformConvolver(std::size_t headSize, std::size_t maxIRLength)
+    : headSize_(std::max<std::size_t>(32, headSize)),
+      maxIRLength_(maxIRLength) {
+    headHistory_.assign(headSize_ * 2, 0.0f);
+    for (auto& taps : headTaps_) {
+        taps.assign(kBands * headSize_, 0.0f);
+    }
+
+    // Every segment starts at offset >= 2 * partitionSize, which is what buys
+    // one partition of slack for pacing its work.
+    std::size_t offset = headSize_;
+    std::size_t partitionSize = headSize_ / 2;
+    std::size_t tailSpan = 0;
+    std::size_t transformItems = 0;
+    while (offset < maxIRLength_) {
+        const bool last = partitionSize >= kMaxPartitionSize || offset + 2 * partitionSize >= maxIRLength_;
+        const std::size_t count = last ? (maxIRLength_ - offset + partitionSize - 1) / partitionSize : 2;
+        auto segment = std::make_unique<Segment>(partitionSize, offset, count);
+        segment->firstTransformItem = transformItems;
+        transformItems += kBands * count;
+        tailSpan = std::max(tailSpan, offset + 2 * partitionSize);
+        offset += count * partitionSize;
+        segments_.push_back(std::move(segment));
+        if (last) {
+            break;
+        }
+        partitionSize *= 2;
+    }
+    transformTotal_ = transformItems;
+
+    std::size_t ring = 1;
+    while (ring < tailSpan) {
+        ring <<= 1;
+    }
+    tailOut_.assign(kBands * ring, 0.0f);
+    tailMask_ = ring - 1;
+
+    staging_.assign(kBands * std::max(offset, headSize_), 0.0f);
+}
+
+NonUniformConvolver::~NonUniformConvolver() = default;
+
+bool NonUniformConvolver::readyForIRs() const noexcept {
+    if (transformActive_ || headCrossfading_) {
+        return false;
+    }
+    for (const auto& segment : segments_) {
+        if (segment->switchPending || segment->crossfade) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void NonUniformConvolver::reset() {
+    std::fill(headHistory_.begin(), headHistory_.end(), 0.0f);
+    std::fill(tailOut_.begin(), tailOut_.end(), 0.0f);
+    headWrite_ = 0;
+    headCrossfading_ = false;
+    time_ = 0;
+    transformActive_ = false;
+    for (auto& segment : segments_) {
+        std::fill(segment->inputBlock.begin(), segment->inputBlock.end(), 0.0f);
+        std::fill(segment->fdlRe.begin(), segment->fdlRe.end(), 0.0f);
+        std::fill(segment->fdlIm.begin(), segment->fdlIm.end(), 0.0f);
+        segment->inputPos = 0;
+        segment->fdlHead = 0;
+        segment->inFlight = false;
+        segment->crossfade = false;
+        segment->switchPending = false;
+    }
+}
+
+void NonUniformConvolver::setIRs(const std::array<ConvolverBandIR, kBands>& bands) {
+    const std::size_t stride = staging_.size() / kBands;
+    const std::size_t set = 1 - headActive_;
+    for (std::size_t b = 0; b < kBands; ++b) {
+        float* dst = staging_.data() + b * stride;
+        stagingSize_[b] = foldBandIR(bands[b], dst, stride);
+        std::copy(dst, dst + headSize_, headTaps_[set].begin() + static_cast<std::ptrdiff_t>(b * headSize_));
+    }
+
+    for (auto& segment : segments_) {
+        const std::size_t segSet = 1 - segment->activeFilter;
+        for (std::size_t b = 0; b < kBands; ++b) {
+            const std::size_t size = stagingSize_[b];
+            const std::size_t covered = size > segment->offset ? size - segment->offset : 0;
+            segment->bandPartitions[segSet][b] = std::min(segment->numPartitions, (covered + segment->partitionSize - 1) / segment->partitionSize);
+        }
+    }
+
+    transformDone_ = 0;
+    transformElapsed_ = 0;
+    transformActive_ = true;
+}
+
+void NonUniformConvolver::loadIRs(const std::array<ConvolverBandIR, kBands>& bands) {
+    setIRs(bands);
+    advanceTransform(transformTotal_);
+    transformActive_ = false;
+    headActive_ = 1 - headActive_;
+    for (auto& segment : segments_) {
+        segment->activeFilter = 1 - segment->activeFilter;
+        segment->switchPending = false;
+    }
+}
+
+void NonUniformConvolver::transformItem(std::size_t item) {
+    for (auto& segmentPtr : segments_) {
+        Segment& segment = *segmentPtr;
+        const std::size_t count = kBands * segment.numPartitions;
+        if (item >= segment.firstTransformItem + count) {
+            continue;
+        }
+
+        const std::size_t local = item - segment.firstTransformItem;
+        const std::size_t band = local / segment.numPartitions;
+        const std::size_t partition = local % segment.numPartitions;
+        const std::size_t set = 1 - segment.activeFilter;
+        if (partition >= segment.bandPartitions[set][band]) {
+            return;
+        }
+
+        const std::size_t stride = staging_.size() / kBands;
+        const float* src = staging_.data() + band * stride + segment.offset + partition * segment.partitionSize;
+        std::copy(src, src + segment.partitionSize, segment.timeScratch.begin());
+        std::fill(segment.timeScratch.begin() + static_cast<std::ptrdiff_t>(segment.partitionSize), segment.timeScratch.end(), 0.0f);
+        const std::size_t offset = segment.filterOffset(band, partition);
+        segment.fft.forward(segment.timeScratch.data(), segment.filterRe[set].data() + offset, segment.filterIm[set].data() + offset);
+        return;
+    }
+}
+
+void NonUniformConvolver::advanceTransform(std::size_t target) {
+    target = std::min(target, transformTotal_);
+    while (transformDone_ < target) {
+        transformItem(transformDone_++);
+    }
+}
+
+void NonUniformConvolver::finishSwitch() {
+    transformActive_ = false;
+    headCrossfading_ = true;
+    headCrossfadePos_ = 0;
+    for (auto& segment : segments_) {
+        segment->switchPending = true;
+    }
+}
+
+void NonUniformConvolver::startBlock(Segment& segment) {
+    if (segment.inFlight) {
+        advanceBlock(segment, segment.workTotal);
+    }
+
+    std::copy(segment.inputBlock.begin(), segment.inputBlock.end(), segment.pendingInput.begin());
+    std::copy(segment.inputBlock.begin() + static_cast<std::ptrdiff_t>(segment.partitionSize), segment.inputBlock.end(), segment.inputBlock.begin());
+    segment.fdlHead = (segment.fdlHead + 1) % segment.numPartitions;
+
+    segment.crossfade = segment.switchPending;
+    segment.switchPending = false;
+    const std::size_t active = segment.activeFilter;
+    std::size_t work = 1 + kBands;
+    for (std::size_t b = 0; b < kBands; ++b) {
+        std::size_t parts = segment.bandPartitions[active][b];
+        if (segment.crossfade) {
+            parts = std::max(parts, segment.bandPartitions[1 - active][b]);
+        }
+        segment.blockPartitions[b] = parts;
+        work += parts;
+    }
+
+    // The block just completed covers inputs [time_ + 1 - P, time_]; its output
+    // belongs `offset` samples later.
+    segment.blockTime = time_ + 1 - segment.partitionSize + segment.offset;
+    segment.stage = Segment::Stage::Forward;
+    segment.cursorBand = 0;
+    segment.cursorPartition = 0;
+    segment.workTotal = work;
+    segment.workDone = 0;
+    segment.samplesSinceStart = 0;
+    segment.inFlight = true;
+}
+
+void NonUniformConvolver::advanceBlock(Segment& segment, std::size_t target) {
+    const std::size_t bins = segment.numBins;
+    const std::size_t active = segment.activeFilter;
+    const std::size_t other = 1 - active;
+
+    while (segment.workDone < target && segment.stage != Segment::Stage::Done) {
+        ++segment.workDone;
+        switch (segment.stage) {
+        case Segment::Stage::Forward: {
+            const std::size_t slot = segment.fdlHead * bins;
+            segment.fft.forward(segment.pendingInput.data(), segment.fdlRe.data() + slot, segment.fdlIm.data() + slot);
+            std::fill(segment.accRe.begin(), segment.accRe.end(), 0.0f);
+            std::fill(segment.accIm.begin(), segment.accIm.end(), 0.0f);
+            std::fill(segment.crossRe.begin(), segment.crossRe.end(), 0.0f);
+            std::fill(segment.crossIm.begin(), segment.crossIm.end(), 0.0f);
+            segment.stage = Segment::Stage::Accumulate;
+            break;
+        }
+        case Segment::Stage::Accumulate: {
+            while (segment.cursorBand < kBands && segment.cursorPartition >= segment.blockPartitions[segment.cursorBand]) {
+                ++segment.cursorBand;
+                segment.cursorPartition = 0;
+            }
+            if (segment.cursorBand >= kBands) {
+                // Nothing left to accumulate; this item is the first inverse.
+                --segment.workDone;
+                segment.stage = Segment::Stage::Inverse;
+                segment.cursorBand = 0;
+                break;
+            }
+
+            const std::size_t b = segment.cursorBand;
+            const std::size_t p = segment.cursorPartition;
+            const std::size_t slot = ((segment.fdlHead + segment.numPartitions - p) % segment.numPartitions) * bins;
+            const float* xRe = segment.fdlRe.data() + slot;
+            const float* xIm = segment.fdlIm.data() + slot;
+            float* aRe = segment.accRe.data() + b * bins;
+            float* aIm = segment.accIm.data() + b * bins;
+            if (p < segment.bandPartitions[active][b]) {
+                const float* hRe = segment.filterRe[active].data() + segment.filterOffset(b, p);
+                const float* hIm = segment.filterIm[active].data() + segment.filterOffset(b, p);
+                for (std::size_t k = 0; k < bins; ++k) {
+                    aRe[k] += xRe[k] * hRe[k] - xIm[k] * hIm[k];
+                    aIm[k] += xRe[k] * hIm[k] + xIm[k] * hRe[k];
+                }
+            }
+            if (segment.crossfade && p < segment.bandPartitions[other][b]) {
+                const float* hRe = segment.filterRe[other].data() + segment.filterOffset(b, p);
+                const float* hIm = segment.filterIm[other].data() + segment.filterOffset(b, p);
+                float* cRe = segment.crossRe.data() + b * bins;
+                float* cIm = segment.crossIm.data() + b * bins;
+                for (std::size_t k = 0; k < bins; ++k) {
+                    cRe[k] += xRe[k] * hRe[k] - xIm[k] * hIm[k];
+                    cIm[k] += xRe[k] * hIm[k] + xIm[k] * hRe[k];
+                }
+            }
+            ++segment.cursorPartition;
+            break;
+        }
+        case Segment::Stage::Inverse: {
+            const std::size_t b = segment.cursorBand;
+            const std::size_t size = segment.partitionSize;
+            segment.fft.inverse(segment.accRe.data() + b * bins, segment.accIm.data() + b * bins, segment.timeScratch.data());
+            const float* out = segment.timeScratch.data() + size;
+            float* tail = tailOut_.data() + b * (tailMask_ + 1);
+            if (segment.crossfade) {
+                segment.fft.inverse(segment.crossRe.data() + b * bins, segment.crossIm.data() + b * bins, segment.crossScratch.data());
+                const float* next = segment.crossScratch.data() + size;
+                const float step = 1.0f / static_cast<float>(size);
+                for (std::size_t n = 0; n < size; ++n) {
+                    const float t = static_cast<float>(n + 1) * step;
+                    tail[(segment.blockTime + n) & tailMask_] += out[n] + (next[n] - out[n]) * t;
+                }
+            } else {
+                for (std::size_t n = 0; n < size; ++n) {
+                    tail[(segment.blockTime + n) & tailMask_] += out[n];
+                }
+            }
+
+            if (++segment.cursorBand >= kBands) {
+                segment.stage = Segment::Stage::Done;
+                segment.inFlight = false;
+                if (segment.crossfade) {
+                    segment.activeFilter = other;
+                    segment.crossfade = false;
+                }
+            }
+            break;
+        }
+        case Segment::Stage::Done:
+            break;
+        }
+    }
+}
+
+void NonUniformConvolver::process(float input, float* bandOut) {
+    if (transformActive_) {
+        ++transformElapsed_;
+        advanceTransform((transformTotal_ * transformElapsed_ + kTransformSpanSamples - 1) / kTransformSpanSamples);
+        if (transformDone_ >= transformTotal_) {
+            finishSwitch();
+        }
+    }
+
+    for (auto& segmentPtr : segments_) {
+        Segment& segment = *segmentPtr;
+        if (segment.inFlight) {
+            ++segment.samplesSinceStart;
+            const std::size_t target = (segment.workTotal * segment.samplesSinceStart + segment.partitionSize - 1) / segment.partitionSize;
+            advanceBlock(segment, target);
+        }
+    }
+
+    headHistory_[headWrite_] = input;
+    headHistory_[headWrite_ + headSize_] = input;
+    const float* x = headHistory_.data() + headWrite_ + headSize_;
+
+    for (auto& segmentPtr : segments_) {
+        Segment& segment = *segmentPtr;
+        segment.inputBlock[segment.partitionSize + segment.inputPos] = input;
+        if (++segment.inputPos == segment.partitionSize) {
+            segment.inputPos = 0;
+            startBlock(segment);
+        }
+    }
+
+    const std::size_t ringSize = tailMask_ + 1;
+    const std::size_t tailIndex = time_ & tailMask_;
+    for (std::size_t b = 0; b < kBands; ++b) {
+        const float* taps = headTaps_[headActive_].data() + b * headSize_;
+        float sum = 0.0f;
+        for (std::size_t k = 0; k < headSize_; ++k) {
+            sum += taps[k] * x[-static_cast<std::ptrdiff_t>(k)];
+        }
+        if (headCrossfading_) {
+            const float* next = headTaps_[1 - headActive_].data() + b * headSize_;
+            float nextSum = 0.0f;
+            for (std::size_t k = 0; k < headSize_; ++k) {
+                nextSum += next[k] * x[-static_cast<std::ptrdiff_t>(k)];
+            }
+            const float t = static_cast<float>(headCrossfadePos_ + 1) / static_cast<float>(headSize_);
+            sum += (nextSum - sum) * t;
+        }
+
+        float& tail = tailOut_[b * ringSize + tailIndex];
+        bandOut[b] = sum + tail;
+        tail = 0.0f;
+    }
+
+    if (headCrossfading_ && ++headCrossfadePos_ >= headSize_) {
+        headCrossfading_ = false;
+        headActive_ = 1 - headActive_;
+    }
+    headWrite_ = (headWrite_ + 1) % headSize_;
+    ++time_;
+}
+
+} // namespace verbsuite
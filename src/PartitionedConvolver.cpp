@@ -0,0 +1,174 @@
+#include "VerbSuite/PartitionedConvolver.h"
+
+#include <algorithm>
+
+namespace verbsuite {
+namespace {
+// Target number of samples over which a full set of new IR spectra is built.
+// The living IR drifts slowly enough that ~40 ms of spectral lag is inaudible,
+// and it keeps the transform work per block independent of IR length.
+constexpr std::size_t kTransformSpanSamples = 2048;
+} // namespace
+
+PartitionedConvolver::PartitionedConvolver(std::size_t partitionSize, std::size_t maxIRLength)
+    : partitionSize_(partitionSize),
+      fftSize_(partitionSize * 2),
+      numBins_(partitionSize + 1),
+      numPartitions_(std::max<std::size_t>(1, (maxIRLength + partitionSize - 1) / partitionSize)),
+      fft_(partitionSize * 2) {
+    const std::size_t blocksPerTransform = std::max<std::size_t>(1, kTransformSpanSamples / partitionSize_);
+    transformsPerBlock_ = std::max<std::size_t>(1, (kBands * numPartitions_ + blocksPerTransform - 1) / blocksPerTransform);
+
+    inputBlock_.assign(fftSize_, 0.0f);
+    fdlRe_.assign(numPartitions_ * numBins_, 0.0f);
+    fdlIm_.assign(numPartitions_ * numBins_, 0.0f);
+    for (std::size_t set = 0; set < 2; ++set) {
+        filterRe_[set].assign(kBands * numPartitions_ * numBins_, 0.0f);
+        filterIm_[set].assign(kBands * numPartitions_ * numBins_, 0.0f);
+    }
+    staging_.assign(kBands * numPartitions_ * partitionSize_, 0.0f);
+    accRe_.assign(numBins_, 0.0f);
+    accIm_.assign(numBins_, 0.0f);
+    timeScratch_.assign(fftSize_, 0.0f);
+    crossfadeScratch_.assign(partitionSize_, 0.0f);
+    output_.assign(kBands * partitionSize_, 0.0f);
+}
+
+std::size_t PartitionedConvolver::filterOffset(std::size_t band, std::size_t partition) const noexcept {
+    return (band * numPartitions_ + partition) * numBins_;
+}
+
+void PartitionedConvolver::reset() {
+    std::fill(inputBlock_.begin(), inputBlock_.end(), 0.0f);
+    std::fill(fdlRe_.begin(), fdlRe_.end(), 0.0f);
+    std::fill(fdlIm_.begin(), fdlIm_.end(), 0.0f);
+    std::fill(output_.begin(), output_.end(), 0.0f);
+    inputPos_ = 0;
+    fdlHead_ = 0;
+}
+
+void PartitionedConvolver::stageIRs(const std::array<ConvolverBandIR, kBands>& bands) {
+    const std::size_t bandStride = numPartitions_ * partitionSize_;
+    for (std::size_t b = 0; b < kBands; ++b) {
+        stagingSize_[b] = foldBandIR(bands[b], staging_.data() + b * bandStride, bandStride);
+    }
+}
+
+void PartitionedConvolver::transformPartition(std::size_t index) {
+    const std::size_t set = 1 - activeFilter_;
+    const std::size_t band = index / numPartitions_;
+    const std::size_t partition = index % numPartitions_;
+    const float* src = staging_.data() + band * numPartitions_ * partitionSize_ + partition * partitionSize_;
+
+    std::copy(src, src + partitionSize_, timeScratch_.begin());
+    std::fill(timeScratch_.begin() + static_cast<std::ptrdiff_t>(partitionSize_), timeScratch_.end(), 0.0f);
+    const std::size_t offset = filterOffset(band, partition);
+    fft_.forward(timeScratch_.data(), filterRe_[set].data() + offset, filterIm_[set].data() + offset);
+}
+
+void PartitionedConvolver::setIRs(const std::array<ConvolverBandIR, kBands>& bands) {
+    stageIRs(bands);
+    const std::size_t set = 1 - activeFilter_;
+    for (std::size_t b = 0; b < kBands; ++b) {
+        bandPartitions_[set][b] = (stagingSize_[b] + partitionSize_ - 1) / partitionSize_;
+    }
+    transformCursor_ = 0;
+    transformActive_ = true;
+}
+
+void PartitionedConvolver::loadIRs(const std::array<ConvolverBandIR, kBands>& bands) {
+    setIRs(bands);
+    while (transformActive_) {
+        advanceTransform();
+    }
+    activeFilter_ = 1 - activeFilter_;
+    crossfadePending_ = false;
+}
+
+void PartitionedConvolver::advanceTransform() {
+    const std::size_t set = 1 - activeFilter_;
+    const std::size_t total = kBands * numPartitions_;
+    std::size_t budget = transformsPerBlock_;
+    while (budget > 0 && transformCursor_ < total) {
+        const std::size_t band = transformCursor_ / numPartitions_;
+        const std::size_t partition = transformCursor_ % numPartitions_;
+        if (partition >= bandPartitions_[set][band]) {
+            // Past the end of this band's IR: nothing to transform.
+            transformCursor_ = (band + 1) * numPartitions_;
+            continue;
+        }
+        transformPartition(transformCursor_++);
+        --budget;
+    }
+    if (transformCursor_ >= total) {
+        transformActive_ = false;
+        crossfadePending_ = true;
+    }
+}
+
+void PartitionedConvolver::accumulateBand(std::size_t filterSet, std::size_t band, float* out) {
+    std::fill(accRe_.begin(), accRe_.end(), 0.0f);
+    std::fill(accIm_.begin(), accIm_.end(), 0.0f);
+
+    const std::size_t parts = bandPartitions_[filterSet][band];
+    const float* hReBase = filterRe_[filterSet].data();
+    const float* hImBase = filterIm_[filterSet].data();
+    for (std::size_t p = 0; p < parts; ++p) {
+        const std::size_t slot = (fdlHead_ + numPartitions_ - p) % numPartitions_;
+        const float* xRe = fdlRe_.data() + slot * numBins_;
+        const float* xIm = fdlIm_.data() + slot * numBins_;
+        const float* hRe = hReBase + filterOffset(band, p);
+        const float* hIm = hImBase + filterOffset(band, p);
+        for (std::size_t k = 0; k < numBins_; ++k) {
+            accRe_[k] += xRe[k] * hRe[k] - xIm[k] * hIm[k];
+            accIm_[k] += xRe[k] * hIm[k] + xIm[k] * hRe[k];
+        }
+    }
+
+    fft_.inverse(accRe_.data(), accIm_.data(), timeScratch_.data());
+    // Overlap-save: the second half is the valid linear-convolution output.
+    std::copy(timeScratch_.begin() + static_cast<std::ptrdiff_t>(partitionSize_), timeScratch_.end(), out);
+}
+
+void PartitionedConvolver::processPartitionBlock() {
+    fdlHead_ = (fdlHead_ + 1) % numPartitions_;
+    fft_.forward(inputBlock_.data(), fdlRe_.data() + fdlHead_ * numBins_, fdlIm_.data() + fdlHead_ * numBins_);
+
+    const std::size_t previous = activeFilter_;
+    const bool crossfade = crossfadePending_;
+    for (std::size_t b = 0; b < kBands; ++b) {
+        float* out = output_.data() + b * partitionSize_;
+        accumulateBand(previous, b, out);
+        if (crossfade) {
+            accumulateBand(1 - previous, b, crossfadeScratch_.data());
+            const float step = 1.0f / static_cast<float>(partitionSize_);
+            for (std::size_t n = 0; n < partitionSize_; ++n) {
+                const float t = static_cast<float>(n + 1) * step;
+                out[n] += (crossfadeScratch_[n] - out[n]) * t;
+            }
+        }
+    }
+    if (crossfade) {
+        activeFilter_ = 1 - previous;
+        crossfadePending_ = false;
+    }
+
+    if (transformActive_) {
+        advanceTransform();
+    }
+
+    std::copy(inputBlock_.begin() + static_cast<std::ptrdiff_t>(partitionSize_), inputBlock_.end(), inputBlock_.begin());
+}
+
+void PartitionedConvolver::process(float input, float* bandOut) {
+    inputBlock_[partitionSize_ + inputPos_] = input;
+    for (std::size_t b = 0; b < kBands; ++b) {
+        bandOut[b] = output_[b * partitionSize_ + inputPos_];
+    }
+    if (++inputPos_ == partitionSize_) {
+        inputPos_ = 0;
+        processPartitionBlock();
+    }
+}
+
+} // namespace verbsuite
@@ -19,6 +19,8 @@ constexpr const char* kOutputParam = "output";
 constexpr const char* kFreezeParam = "freeze";
 constexpr const char* kFreezeModeParam = "freeze_mode";
 constexpr const char* kOversampleHqParam = "oversample_hq";
+constexpr const char* kOversampleLiveParam = "oversample_live";
+constexpr const char* kFullTailsParam = "full_tails";
 
 void styleSmallLabel(juce::Label& label) {
     label.setColour(juce::Label::textColourId, juce::Colour(0xffd7c7b2).withAlpha(0.82f));
@@ -75,6 +77,7 @@ VerbSuiteAudioProcessorEditor::VerbSuiteAudioProcessorEditor(VerbSuiteAudioProce
     cvSmoothingBox_.addItemList({ "Raw", "Envelope" }, 1);
     cvFilterTimeBox_.addItemList({ "Fast", "Medium", "Slow" }, 1);
     freezeModeBox_.addItemList({ "Latch", "Momentary" }, 1);
+    hqLiveBox_.addItemList({ "HQ Live Off", "HQ Live 2x", "HQ Live 4x" }, 1);
 
     for (int i = 0; i < processor_.getNumPrograms(); ++i) {
         presetBox_.addItem(processor_.getProgramName(i), i + 1);
@@ -115,7 +118,7 @@ VerbSuiteAudioProcessorEditor::VerbSuiteAudioProcessorEditor(VerbSuiteAudioProce
         addAndMakeVisible(*l);
     }
 
-    for (auto* c : { &presetBox_, &modeBox_, &irBankBox_, &breathSyncBox_, &cvModeBox_, &cvSmoothingBox_, &cvFilterTimeBox_, &freezeModeBox_ }) {
+    for (auto* c : { &presetBox_, &modeBox_, &irBankBox_, &breathSyncBox_, &cvModeBox_, &cvSmoothingBox_, &cvFilterTimeBox_, &freezeModeBox_, &hqLiveBox_ }) {
         styleCombo(*c);
         addAndMakeVisible(*c);
     }
@@ -134,17 +137,20 @@ VerbSuiteAudioProcessorEditor::VerbSuiteAudioProcessorEditor(VerbSuiteAudioProce
 
     freezeButton_.setButtonText("Freeze");
     hqExportButton_.setButtonText("HQ Export");
+    fullTailsButton_.setButtonText("Full Tails");
     lockCoreButton_.setButtonText("Lock Core");
     lockCoreButton_.setClickingTogglesState(true);
     randomizeButton_.setButtonText("Randomize");
 
     styleButton(freezeButton_);
     styleButton(hqExportButton_);
+    styleButton(fullTailsButton_);
     styleButton(lockCoreButton_);
     styleButton(randomizeButton_);
 
     addAndMakeVisible(freezeButton_);
     addAndMakeVisible(hqExportButton_);
+    addAndMakeVisible(fullTailsButton_);
     addAndMakeVisible(lockCoreButton_);
     addAndMakeVisible(randomizeButton_);
 
@@ -183,6 +189,7 @@ VerbSuiteAudioProcessorEditor::VerbSuiteAudioProcessorEditor(VerbSuiteAudioProce
     cvModeAttachment_ = std::make_unique<ChoiceAttachment>(processor_.parameters(), kCvModeParam, cvModeBox_);
     cvSmoothingAttachment_ = std::make_unique<ChoiceAttachment>(processor_.parameters(), kCvSmoothingParam, cvSmoothingBox_);
     cvFilterTimeAttachment_ = std::make_unique<ChoiceAttachment>(processor_.parameters(), kCvFilterTimeParam, cvFilterTimeBox_);
+    hqLiveAttachment_ = std::make_unique<ChoiceAttachment>(processor_.parameters(), kOversampleLiveParam, hqLiveBox_);
 
     stabilityAttachment_ = std::make_unique<SliderAttachment>(processor_.parameters(), kStabilityParam, stabilitySlider_);
     breathRateAttachment_ = std::make_unique<SliderAttachment>(processor_.parameters(), kBreathRateParam, breathRateSlider_);
@@ -194,6 +201,7 @@ VerbSuiteAudioProcessorEditor::VerbSuiteAudioProcessorEditor(VerbSuiteAudioProce
 
     freezeAttachment_ = std::make_unique<ButtonAttachment>(processor_.parameters(), kFreezeParam, freezeButton_);
     hqExportAttachment_ = std::make_unique<ButtonAttachment>(processor_.parameters(), kOversampleHqParam, hqExportButton_);
+    fullTailsAttachment_ = std::make_unique<ButtonAttachment>(processor_.parameters(), kFullTailsParam, fullTailsButton_);
 
     presetBox_.setSelectedId(processor_.getCurrentProgram() + 1, juce::dontSendNotification);
 
@@ -291,9 +299,13 @@ void VerbSuiteAudioProcessorEditor::resized() {
     buttonRow.removeFromLeft(btnGap);
     hqExportButton_.setBounds(buttonRow.removeFromLeft(btnW + 6));
     buttonRow.removeFromLeft(btnGap);
+    fullTailsButton_.setBounds(buttonRow.removeFromLeft(btnW + 6));
+    buttonRow.removeFromLeft(btnGap);
     lockCoreButton_.setBounds(buttonRow.removeFromLeft(btnW + 6));
     buttonRow.removeFromLeft(btnGap);
     randomizeButton_.setBounds(buttonRow.removeFromLeft(btnW + 14));
+    buttonRow.removeFromLeft(btnGap);
+    hqLiveBox_.setBounds(buttonRow.removeFromLeft(btnW + 14));
 
     area.removeFromTop(18);
 
@@ -23,6 +23,7 @@ private:
     juce::ComboBox cvSmoothingBox_;
     juce::ComboBox cvFilterTimeBox_;
     juce::ComboBox freezeModeBox_;
+    juce::ComboBox hqLiveBox_;
     juce::Slider stabilitySlider_;
     juce::Slider breathRateSlider_;
     juce::Slider breathDepthSlider_;
@@ -32,6 +33,7 @@ private:
     juce::Slider outputSlider_;
     juce::ToggleButton freezeButton_;
     juce::ToggleButton hqExportButton_;
+    juce::ToggleButton fullTailsButton_;
     juce::ToggleButton lockCoreButton_;
     juce::TextButton randomizeButton_;
 
@@ -63,6 +65,7 @@ private:
     std::unique_ptr<ChoiceAttachment> cvModeAttachment_;
     std::unique_ptr<ChoiceAttachment> cvSmoothingAttachment_;
     std::unique_ptr<ChoiceAttachment> cvFilterTimeAttachment_;
+    std::unique_ptr<ChoiceAttachment> hqLiveAttachment_;
     std::unique_ptr<SliderAttachment> stabilityAttachment_;
     std::unique_ptr<SliderAttachment> breathRateAttachment_;
     std::unique_ptr<SliderAttachment> breathDepthAttachment_;
@@ -72,6 +75,7 @@ private:
     std::unique_ptr<SliderAttachment> outputAttachment_;
     std::unique_ptr<ButtonAttachment> freezeAttachment_;
     std::unique_ptr<ButtonAttachment> hqExportAttachment_;
+    std::unique_ptr<ButtonAttachment> fullTailsAttachment_;
 
     void timerCallback() override;
 
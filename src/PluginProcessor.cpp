@@ -23,6 +23,18 @@ constexpr const char* kIrBankParam = "ir_bank";
 constexpr const char* kFreezeParam = "freeze";
 constexpr const char* kFreezeModeParam = "freeze_mode";
 constexpr const char* kOversampleHqParam = "oversample_hq";
+constexpr const char* kOversampleLiveParam = "oversample_live";
+constexpr const char* kFullTailsParam = "full_tails";
+
+constexpr std::array<const char*, 18> kParameterIds = {
+    kModeParam, kIrBankParam, kStabilityParam, kBreathSyncParam, kBreathRateParam, kBreathDepthParam,
+    kCvModeParam, kCvAmountParam, kCvSmoothingParam, kCvFilterTimeParam, kDryParam, kWetParam,
+    kOutputParam, kFreezeParam, kFreezeModeParam, kOversampleHqParam, kOversampleLiveParam, kFullTailsParam,
+};
+
+// Dry, wet and the continuous macro controls ramp inside the engines, the
+// output gain here, over this long.
+constexpr double kSmoothingSeconds = 0.02;
 
 float breathSyncToBeats(int syncIndex) {
     switch (syncIndex) {
@@ -45,6 +57,17 @@ float cvFilterTimeSeconds(int index) {
     }
 }
 
+// Engine control tick at the host rate. The HQ engines tick at the same
+// moments, every kControlInterval * factor of their samples, so both paths
+// read the same control-rate CV and ramp between its values.
+constexpr std::size_t kControlInterval = 16;
+
+// Surround layouts send every channel but the LFE through the engine's
+// multichannel form; the LFE passes through dry.
+bool isReverbChannel(juce::AudioChannelSet::ChannelType type) {
+    return type != juce::AudioChannelSet::LFE && type != juce::AudioChannelSet::LFE2;
+}
+
 struct FactoryPreset {
     const char* name;
     int mode;
@@ -102,23 +125,194 @@ VerbSuiteAudioProcessor::VerbSuiteAudioProcessor()
                                .withInput("Sidechain", juce::AudioChannelSet::stereo(), false)
                                .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
       parameters_(*this, nullptr, "PARAMETERS", createParameterLayout()) {
+    auto& p = parameterPointers_;
+    p.mode = parameters_.getRawParameterValue(kModeParam);
+    p.irBank = parameters_.getRawParameterValue(kIrBankParam);
+    p.stability = parameters_.getRawParameterValue(kStabilityParam);
+    p.breathSync = parameters_.getRawParameterValue(kBreathSyncParam);
+    p.breathRate = parameters_.getRawParameterValue(kBreathRateParam);
+    p.breathDepth = parameters_.getRawParameterValue(kBreathDepthParam);
+    p.cvMode = parameters_.getRawParameterValue(kCvModeParam);
+    p.cvAmount = parameters_.getRawParameterValue(kCvAmountParam);
+    p.cvSmoothing = parameters_.getRawParameterValue(kCvSmoothingParam);
+    p.cvFilterTime = parameters_.getRawParameterValue(kCvFilterTimeParam);
+    p.dry = parameters_.getRawParameterValue(kDryParam);
+    p.wet = parameters_.getRawParameterValue(kWetParam);
+    p.output = parameters_.getRawParameterValue(kOutputParam);
+    p.freeze = parameters_.getRawParameterValue(kFreezeParam);
+    p.freezeMode = parameters_.getRawParameterValue(kFreezeModeParam);
+    p.oversampleHq = parameters_.getRawParameterValue(kOversampleHqParam);
+    p.oversampleLive = parameters_.getRawParameterValue(kOversampleLiveParam);
+    p.fullTails = parameters_.getRawParameterValue(kFullTailsParam);
+    for (const char* id : kParameterIds) {
+        parameters_.addParameterListener(id, this);
+    }
+
     setCurrentProgram(0);
+    startTimerHz(20);
+}
+
+VerbSuiteAudioProcessor::~VerbSuiteAudioProcessor() {
+    stopTimer();
+    for (const char* id : kParameterIds) {
+        parameters_.removeParameterListener(id, this);
+    }
+}
+
+void VerbSuiteAudioProcessor::parameterChanged(const juce::String&, float) {
+    parametersDirty_.store(true, std::memory_order_release);
+}
+
+void VerbSuiteAudioProcessor::refreshSnapshot() {
+    const auto& p = parameterPointers_;
+    auto& s = snapshot_;
+    s.mode = verbsuite::WeirdConvolutionReverb::modeFromIndex(static_cast<int>(p.mode->load()));
+    s.stability = p.stability->load();
+    const int breathSync = static_cast<int>(p.breathSync->load());
+    s.tempoSync = breathSync > 0;
+    s.breathBeats = breathSyncToBeats(breathSync);
+    s.breathRateHz = p.breathRate->load();
+    s.breathDepth = p.breathDepth->load();
+    s.wildIrBank = static_cast<int>(p.irBank->load()) == 1;
+
+    s.sidechainCv = static_cast<int>(p.cvMode->load()) == 1;
+    s.cvAmount = p.cvAmount->load();
+    const int cvSmoothing = static_cast<int>(p.cvSmoothing->load());
+    const int cvFilterTime = static_cast<int>(p.cvFilterTime->load());
+    const float tau = cvFilterTimeSeconds(cvFilterTime);
+    s.cvSettings.shape = cvSmoothing == 1 ? verbsuite::CVShape::Envelope : verbsuite::CVShape::Raw;
+    s.cvSettings.attackSeconds = std::max(0.001f, tau * 0.30f);
+    s.cvSettings.releaseSeconds = std::max(0.005f, tau * 2.40f);
+    s.cvSettings.holdPeriod = cvFilterTime == 0 ? 12 : (cvFilterTime == 1 ? 48 : 160);
+
+    s.dry = p.dry->load();
+    s.wet = p.wet->load();
+    s.outputGain = juce::Decibels::decibelsToGain(p.output->load());
+    s.freeze = p.freeze->load() > 0.5f;
+    s.momentaryFreeze = static_cast<int>(p.freezeMode->load()) == 1;
+    s.fullTails = p.fullTails->load() > 0.5f;
+}
+
+void VerbSuiteAudioProcessor::timerCallback() {
+    const int stage = hqStage_.load(std::memory_order_acquire);
+    if (stage == kHQRequested) {
+        buildHQEngine(hqRequest_);
+        hqStage_.store(kHQReady, std::memory_order_release);
+    } else if (stage == kHQRetired) {
+        engineHQ_.reset();
+        engineHQIndex_ = -1;
+        hqStage_.store(kHQIdle, std::memory_order_release);
+    }
+}
+
+int VerbSuiteAudioProcessor::wantedHQ() const {
+    // HQ Live oversamples at 2x or 4x on any pass; HQ Export keeps its 2x to
+    // offline renders.
+    const int oversampleLive = static_cast<int>(parameterPointers_.oversampleLive->load());
+    if (oversampleLive > 0) {
+        return juce::jlimit(0, static_cast<int>(oversampling_.size()) - 1, oversampleLive - 1);
+    }
+    const bool oversampleHq = parameterPointers_.oversampleHq->load() > 0.5f;
+    return oversampleHq && isNonRealtime() ? 0 : -1;
+}
+
+int VerbSuiteAudioProcessor::acquireHQ(int wanted) {
+    int stage = hqStage_.load(std::memory_order_acquire);
+    if (stage == kHQReady && engineHQIndex_ != wanted) {
+        hqStage_.store(kHQRetired, std::memory_order_release);
+        stage = kHQRetired;
+    }
+    if (stage == kHQReady) {
+        return wanted;
+    }
+    if (wanted < 0 || stage != kHQIdle) {
+        return -1;
+    }
+    engine_->captureWarmState(warmState_);
+    if (isNonRealtime()) {
+        // Offline passes can wait, and render the whole pass in HQ.
+        buildHQEngine(wanted);
+        hqStage_.store(kHQReady, std::memory_order_release);
+        return wanted;
+    }
+    hqRequest_ = wanted;
+    hqStage_.store(kHQRequested, std::memory_order_release);
+    return -1;
+}
+
+void VerbSuiteAudioProcessor::buildHQEngine(int index) {
+    const std::size_t factor = std::size_t { 2 } << index;
+    engineHQ_ = std::make_unique<verbsuite::WeirdConvolutionReverb>(getSampleRate() * static_cast<double>(factor), static_cast<std::size_t>(maxBlockSize_) * factor, verbsuite::WeirdMode::LivingSignal);
+    engineHQ_->setIRSynthesisMode(synthesisMode_);
+    engineHQ_->setControlInterval(kControlInterval * factor);
+    engineHQ_->setControlSmoothing(kSmoothingSeconds);
+    if (surroundChannelCount_ > 0) {
+        engineHQ_->prepareChannels(surroundChannelCount_);
+    }
+    engineHQ_->warmStart(warmState_);
+    engineHQIndex_ = index;
 }
 
 void VerbSuiteAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
-    engine_ = std::make_unique<verbsuite::WeirdConvolutionReverb>(sampleRate, static_cast<std::size_t>(samplesPerBlock), verbsuite::WeirdMode::LivingSignal);
-    engineHQ_ = std::make_unique<verbsuite::WeirdConvolutionReverb>(sampleRate * 2.0, static_cast<std::size_t>(samplesPerBlock * 2), verbsuite::WeirdMode::LivingSignal);
+    maxBlockSize_ = std::max(1, samplesPerBlock);
+    // Live playback moves IR regeneration off the audio thread; offline bounces
+    // stay inline so they render deterministically.
+    synthesisMode_ = isNonRealtime() ? verbsuite::IRSynthesisMode::Inline : verbsuite::IRSynthesisMode::Background;
+
+    engine_ = std::make_unique<verbsuite::WeirdConvolutionReverb>(sampleRate, static_cast<std::size_t>(maxBlockSize_), verbsuite::WeirdMode::LivingSignal);
     engine_->reset();
-    engineHQ_->reset();
+    engine_->setIRSynthesisMode(synthesisMode_);
+    engine_->setControlInterval(kControlInterval);
+    engine_->setControlSmoothing(kSmoothingSeconds);
+    // Full Tails switches to the zero-latency non-uniform engine from the audio
+    // thread, so its spectra are allocated here.
+    engine_->prepareConvolutionEngine(verbsuite::ConvolutionEngine::NonUniform);
+    engine_->prepareWarmState(warmState_);
+    pathLatency_[0] = static_cast<int>(engine_->latencySamples());
+
+    const auto layout = getChannelLayoutOfBus(true, 0);
+    surroundChannelCount_ = 0;
+    if (layout.size() > 2) {
+        for (int channel = 0; channel < layout.size(); ++channel) {
+            if (isReverbChannel(layout.getTypeOfChannel(channel))) {
+                surroundChannels_[surroundChannelCount_++] = channel;
+            }
+        }
+        engine_->prepareChannels(surroundChannelCount_);
+    }
 
-    oversampling_ = std::make_unique<juce::dsp::Oversampling<float>>(2, 1, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR);
-    oversampling_->initProcessing(static_cast<size_t>(samplesPerBlock));
-    oversampling_->reset();
+    // The oversamplers are small; the HQ engine itself is built when first
+    // wanted (right away if HQ is already on).
+    for (std::size_t stages = 1; stages <= oversampling_.size(); ++stages) {
+        // Integer latency, so the host can compensate it exactly. The HQ
+        // engine stays on the zero-latency direct path.
+        auto& oversampling = oversampling_[stages - 1];
+        oversampling = std::make_unique<juce::dsp::Oversampling<float>>(static_cast<size_t>(std::max(2, layout.size())), stages, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true, true);
+        oversampling->initProcessing(static_cast<size_t>(maxBlockSize_));
+        oversampling->reset();
+        pathLatency_[stages] = static_cast<int>(std::lround(oversampling->getLatencyInSamples()));
+    }
+    engineHQ_.reset();
+    engineHQIndex_ = -1;
+    hqStage_.store(kHQIdle, std::memory_order_release);
+    if (const int wanted = wantedHQ(); wanted >= 0) {
+        engine_->captureWarmState(warmState_);
+        buildHQEngine(wanted);
+        hqStage_.store(kHQReady, std::memory_order_release);
+    }
+    activeHQ_ = -1;
+    reportedLatency_ = pathLatency_[0];
+    setLatencySamples(reportedLatency_);
+
+    cvFollower_.prepare(sampleRate, static_cast<std::size_t>(maxBlockSize_), kControlInterval);
+
+    // The new engines take the current settings, unsmoothed, on their first block.
+    parametersDirty_.store(true, std::memory_order_release);
+    settingsEngine_ = kNoEngine;
+    outputGain_.reset(sampleRate, kSmoothingSeconds);
+    outputGain_.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(parameterPointers_.output->load()));
 
     stabilityCvMeter_.store(0.0f);
-    cvEnvelopeState_ = 0.0f;
-    cvEnvelopeHeld_ = 0.0f;
-    cvEnvelopeStepCounter_ = 0;
     previousFreezeParam_ = false;
     freezeMomentarySamplesRemaining_ = 0;
 }
@@ -126,15 +320,29 @@ void VerbSuiteAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlo
 void VerbSuiteAudioProcessor::releaseResources() {
     engine_.reset();
     engineHQ_.reset();
-    oversampling_.reset();
+    engineHQIndex_ = -1;
+    hqStage_.store(kHQIdle, std::memory_order_release);
+    for (auto& oversampling : oversampling_) {
+        oversampling.reset();
+    }
 }
 
 bool VerbSuiteAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
-    if (layouts.getMainInputChannelSet() != juce::AudioChannelSet::stereo()) {
+    const auto layout = layouts.getMainOutputChannelSet();
+    if (layouts.getMainInputChannelSet() != layout) {
         return false;
     }
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo()) {
-        return false;
+    // Stereo, or a named surround layout (LCR up to 9.1.6) with no more
+    // reverb channels than the engine takes.
+    if (layout != juce::AudioChannelSet::stereo()) {
+        if (layout.size() <= 2 || layout.isDiscreteLayout()) {
+            return false;
+        }
+        const auto types = layout.getChannelTypes();
+        const auto reverbChannels = std::count_if(types.begin(), types.end(), isReverbChannel);
+        if (reverbChannels > static_cast<std::ptrdiff_t>(verbsuite::WeirdConvolutionReverb::kMaxChannels)) {
+            return false;
+        }
     }
 
     const auto sidechain = layouts.getChannelSet(true, 1);
@@ -154,29 +362,24 @@ void VerbSuiteAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juc
     auto* left = mainBuffer.getWritePointer(0);
     auto* right = mainBuffer.getNumChannels() > 1 ? mainBuffer.getWritePointer(1) : mainBuffer.getWritePointer(0);
 
-    const auto modeIndex = static_cast<int>(parameters_.getRawParameterValue(kModeParam)->load());
-    const auto stability = parameters_.getRawParameterValue(kStabilityParam)->load();
-    const auto breathSync = static_cast<int>(parameters_.getRawParameterValue(kBreathSyncParam)->load());
-    const auto breathRateHz = parameters_.getRawParameterValue(kBreathRateParam)->load();
-    const auto breathDepth = parameters_.getRawParameterValue(kBreathDepthParam)->load();
-    const auto irBank = static_cast<int>(parameters_.getRawParameterValue(kIrBankParam)->load());
-    const auto cvMode = static_cast<int>(parameters_.getRawParameterValue(kCvModeParam)->load());
-    const auto cvAmount = parameters_.getRawParameterValue(kCvAmountParam)->load();
-    const auto cvSmoothing = static_cast<int>(parameters_.getRawParameterValue(kCvSmoothingParam)->load());
-    const auto cvFilterTime = static_cast<int>(parameters_.getRawParameterValue(kCvFilterTimeParam)->load());
-    const auto dry = parameters_.getRawParameterValue(kDryParam)->load();
-    const auto wet = parameters_.getRawParameterValue(kWetParam)->load();
-    const auto output = parameters_.getRawParameterValue(kOutputParam)->load();
-    const bool freezeParam = parameters_.getRawParameterValue(kFreezeParam)->load() > 0.5f;
-    const int freezeMode = static_cast<int>(parameters_.getRawParameterValue(kFreezeModeParam)->load());
-    const bool oversampleHq = parameters_.getRawParameterValue(kOversampleHqParam)->load() > 0.5f;
+    const bool refreshed = parametersDirty_.exchange(false, std::memory_order_acq_rel);
+    if (refreshed) {
+        refreshSnapshot();
+    }
+    const auto& params = snapshot_;
+    const bool freezeParam = params.freeze;
 
     bool freezeActive = freezeParam;
-    if (freezeMode == 1) { // momentary
+    // Sample of this block where a momentary freeze lets go, or -1.
+    int freezeRelease = -1;
+    if (params.momentaryFreeze) {
         if (freezeParam && !previousFreezeParam_) {
             freezeMomentarySamplesRemaining_ = std::max(1, static_cast<int>(0.22 * getSampleRate()));
         }
         freezeActive = freezeMomentarySamplesRemaining_ > 0;
+        if (freezeActive && freezeMomentarySamplesRemaining_ < mainBuffer.getNumSamples()) {
+            freezeRelease = freezeMomentarySamplesRemaining_;
+        }
         freezeMomentarySamplesRemaining_ = std::max(0, freezeMomentarySamplesRemaining_ - mainBuffer.getNumSamples());
     }
     previousFreezeParam_ = freezeParam;
@@ -192,101 +395,122 @@ void VerbSuiteAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juc
         }
     }
 
-    const auto mode = verbsuite::WeirdConvolutionReverb::modeFromIndex(modeIndex);
-    const bool tempoSync = breathSync > 0;
-    const float breathBeats = breathSyncToBeats(breathSync);
-
-    const auto controls = controlsFromModeAndStability(
-        mode,
-        stability,
-        breathRateHz,
-        breathDepth,
-        tempoSync,
-        breathBeats,
-        static_cast<float>(bpm),
-        irBank == 1,
-        dry,
-        wet,
-        freezeActive);
-
-    engine_->setMode(mode);
-    engine_->setControls(controls);
-    if (engineHQ_) {
-        engineHQ_->setMode(mode);
-        engineHQ_->setControls(controls);
+    // Until a wanted HQ engine is ready the block runs at 1x.
+    const int hq = acquireHQ(wantedHQ());
+    // Only the engine that runs gets settings, and only when they changed or
+    // it was not the one that got the last ones.
+    auto& active = hq >= 0 ? *engineHQ_ : *engine_;
+    if (refreshed || hq != settingsEngine_ || bpm != settingsBpm_ || freezeActive != settings_.controls.freeze) {
+        verbsuite::EngineSettings settings;
+        settings.mode = params.mode;
+        settings.controls = controlsFromModeAndStability(
+            params.mode,
+            params.stability,
+            params.breathRateHz,
+            params.breathDepth,
+            params.tempoSync,
+            params.breathBeats,
+            static_cast<float>(bpm),
+            params.wildIrBank,
+            params.dry,
+            params.wet,
+            freezeActive);
+        if (hq != settingsEngine_ || settings != settings_) {
+            active.controlBlock().publish(settings);
+            settings_ = settings;
+            settingsEngine_ = hq;
+        }
+        settingsBpm_ = bpm;
+    }
+    if (hq < 0) {
+        engine_->setConvolutionEngine(params.fullTails ? verbsuite::ConvolutionEngine::NonUniform : verbsuite::ConvolutionEngine::Direct);
+    }
+    if (hq != activeHQ_) {
+        if (hq >= 0) {
+            oversampling_[static_cast<std::size_t>(hq)]->reset();
+        }
+        activeHQ_ = hq;
+    }
+    const int latency = pathLatency_[static_cast<std::size_t>(hq + 1)];
+    if (latency != reportedLatency_) {
+        reportedLatency_ = latency;
+        setLatencySamples(latency);
     }
 
-    const float* cvSignal = nullptr;
-    std::vector<float> cvScratch;
+    cvFollower_.setSettings(params.cvSettings);
+    const float cvAmount = params.cvAmount;
 
-    const float tau = cvFilterTimeSeconds(cvFilterTime);
-    const float sr = std::max(1.0f, static_cast<float>(getSampleRate()));
-    const float attackTau = std::max(0.001f, tau * 0.30f);
-    const float releaseTau = std::max(0.005f, tau * 2.40f);
-    const float attackAlpha = 1.0f - std::exp(-1.0f / (attackTau * sr));
-    const float releaseAlpha = 1.0f - std::exp(-1.0f / (releaseTau * sr));
-    const int stepPeriod = cvFilterTime == 0 ? 12 : (cvFilterTime == 1 ? 48 : 160);
-
-    if (cvMode == 1 && getBusCount(true) > 1) {
+    const float* scL = nullptr;
+    const float* scR = nullptr;
+    if (params.sidechainCv && getBusCount(true) > 1) {
         auto sidechainBuffer = getBusBuffer(buffer, true, 1);
         if (sidechainBuffer.getNumChannels() > 0) {
-            cvScratch.resize(static_cast<std::size_t>(mainBuffer.getNumSamples()));
-            const auto* scL = sidechainBuffer.getReadPointer(0);
-            const auto* scR = sidechainBuffer.getNumChannels() > 1 ? sidechainBuffer.getReadPointer(1) : scL;
-
-            float meterPeak = 0.0f;
-            for (int i = 0; i < mainBuffer.getNumSamples(); ++i) {
-                const float raw = juce::jlimit(-1.0f, 1.0f, 0.5f * (scL[i] + scR[i]));
-                float shaped = raw;
-                if (cvSmoothing == 1) {
-                    const float target = std::abs(raw);
-                    const float alpha = target > cvEnvelopeState_ ? attackAlpha : releaseAlpha;
-                    cvEnvelopeState_ += alpha * (target - cvEnvelopeState_);
-                    if ((cvEnvelopeStepCounter_++ % stepPeriod) == 0) {
-                        cvEnvelopeHeld_ = cvEnvelopeState_;
-                    }
-                    shaped = cvEnvelopeHeld_;
-                }
-                cvScratch[static_cast<std::size_t>(i)] = shaped;
-                meterPeak = std::max(meterPeak, std::abs(shaped));
-            }
-            const float held = std::max(stabilityCvMeter_.load() * 0.92f, meterPeak);
-            stabilityCvMeter_.store(held);
-            cvSignal = cvScratch.data();
+            scL = sidechainBuffer.getReadPointer(0);
+            scR = sidechainBuffer.getNumChannels() > 1 ? sidechainBuffer.getReadPointer(1) : scL;
         }
     }
-    if (cvMode != 1) {
-        stabilityCvMeter_.store(stabilityCvMeter_.load() * 0.90f);
-    }
 
-    const bool doHQ = oversampleHq && isNonRealtime() && oversampling_ && engineHQ_;
-    if (doHQ) {
-        juce::dsp::AudioBlock<float> block(mainBuffer);
-        auto upBlock = oversampling_->processSamplesUp(block);
+    float meterPeak = 0.0f;
+    const int numSamples = mainBuffer.getNumSamples();
+    for (int offset = 0; offset < numSamples; offset += maxBlockSize_) {
+        const int n = std::min(maxBlockSize_, numSamples - offset);
+        if (freezeRelease >= offset && freezeRelease < offset + n) {
+            // JUCE hands host automation over per block without timestamps, so
+            // the one change known to land inside a block is this release.
+            const int factor = hq >= 0 ? 2 << hq : 1;
+            active.queueControlEvent({ static_cast<std::uint32_t>((freezeRelease - offset) * factor), verbsuite::ControlTarget::Freeze, 0.0f });
+        }
+
+        const float* cvControl = nullptr;
+        if (scL != nullptr) {
+            cvFollower_.process(scL + offset, scR + offset, static_cast<std::size_t>(n));
+            cvControl = cvFollower_.controlRate().data();
+            meterPeak = std::max(meterPeak, cvFollower_.peak());
+        }
 
-        auto* upL = upBlock.getChannelPointer(0);
-        auto* upR = upBlock.getNumChannels() > 1 ? upBlock.getChannelPointer(1) : upBlock.getChannelPointer(0);
+        if (hq >= 0) {
+            const auto index = static_cast<std::size_t>(hq);
+            auto block = juce::dsp::AudioBlock<float>(mainBuffer).getSubBlock(static_cast<size_t>(offset), static_cast<size_t>(n));
+            auto upBlock = oversampling_[index]->processSamplesUp(block);
 
-        std::vector<float> cvUp;
-        const float* cvUpPtr = nullptr;
-        if (cvSignal != nullptr) {
             const auto upSamples = static_cast<std::size_t>(upBlock.getNumSamples());
-            cvUp.resize(upSamples, 0.0f);
-            for (std::size_t i = 0; i < upSamples; ++i) {
-                const std::size_t src = std::min<std::size_t>(cvScratch.size() - 1, i / 2);
-                cvUp[i] = cvScratch[src];
+            if (surroundChannelCount_ > 0) {
+                for (std::size_t c = 0; c < surroundChannelCount_; ++c) {
+                    channelPointers_[c] = upBlock.getChannelPointer(static_cast<size_t>(surroundChannels_[c]));
+                }
+                engineHQ_->processBlockControlRate(channelPointers_.data(), surroundChannelCount_, upSamples, cvControl, cvAmount);
+            } else {
+                auto* upL = upBlock.getChannelPointer(0);
+                auto* upR = upBlock.getNumChannels() > 1 ? upBlock.getChannelPointer(1) : upBlock.getChannelPointer(0);
+                engineHQ_->processBlockControlRate(upL, upR, upSamples, cvControl, cvAmount);
+            }
+            oversampling_[index]->processSamplesDown(block);
+        } else if (surroundChannelCount_ > 0) {
+            for (std::size_t c = 0; c < surroundChannelCount_; ++c) {
+                channelPointers_[c] = mainBuffer.getWritePointer(surroundChannels_[c]) + offset;
             }
-            cvUpPtr = cvUp.data();
+            engine_->processBlockControlRate(channelPointers_.data(), surroundChannelCount_, static_cast<std::size_t>(n), cvControl, cvAmount);
+        } else {
+            engine_->processBlockControlRate(left + offset, right + offset, static_cast<std::size_t>(n), cvControl, cvAmount);
         }
+    }
 
-        engineHQ_->processBlock(upL, upR, static_cast<std::size_t>(upBlock.getNumSamples()), cvUpPtr, cvAmount);
-        oversampling_->processSamplesDown(block);
-    } else {
-        engine_->processBlock(left, right, static_cast<std::size_t>(mainBuffer.getNumSamples()), cvSignal, cvAmount);
+    if (scL != nullptr) {
+        const float held = std::max(stabilityCvMeter_.load() * 0.92f, meterPeak);
+        stabilityCvMeter_.store(held);
+    }
+    if (!params.sidechainCv) {
+        stabilityCvMeter_.store(stabilityCvMeter_.load() * 0.90f);
     }
 
-    const float gain = juce::Decibels::decibelsToGain(output);
-    mainBuffer.applyGain(gain);
+    const float startGain = outputGain_.getCurrentValue();
+    outputGain_.setTargetValue(params.outputGain);
+    const float endGain = outputGain_.skip(numSamples);
+    if (startGain == endGain) {
+        mainBuffer.applyGain(endGain);
+    } else {
+        mainBuffer.applyGainRamp(0, numSamples, startGain, endGain);
+    }
 
     for (int ch = getTotalNumInputChannels(); ch < getTotalNumOutputChannels(); ++ch) {
         buffer.clear(ch, 0, buffer.getNumSamples());
@@ -385,6 +609,8 @@ juce::AudioProcessorValueTreeState::ParameterLayout VerbSuiteAudioProcessor::cre
     params.push_back(std::make_unique<juce::AudioParameterBool>(kFreezeParam, "Freeze", false));
     params.push_back(std::make_unique<juce::AudioParameterChoice>(kFreezeModeParam, "Freeze Mode", freezeModeNames, 0));
     params.push_back(std::make_unique<juce::AudioParameterBool>(kOversampleHqParam, "HQ Export", false));
+    params.push_back(std::make_unique<juce::AudioParameterBool>(kFullTailsParam, "Full Tails", false));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(kOversampleLiveParam, "HQ Live", juce::StringArray { "Off", "2x", "4x" }, 0));
 
     return { params.begin(), params.end() };
 }
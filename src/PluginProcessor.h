@@ -1,17 +1,21 @@
 #pragma once
 
+#include "VerbSuite/CVFollower.h"
 #include "VerbSuite/WeirdConvolutionReverb.h"
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include <array>
 #include <atomic>
 #include <memory>
 #include <vector>
 
-class VerbSuiteAudioProcessor : public juce::AudioProcessor {
+class VerbSuiteAudioProcessor : public juce::AudioProcessor,
+                                private juce::Timer,
+                                private juce::AudioProcessorValueTreeState::Listener {
 public:
     VerbSuiteAudioProcessor();
-    ~VerbSuiteAudioProcessor() override = default;
+    ~VerbSuiteAudioProcessor() override;
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
@@ -42,6 +46,73 @@ public:
     float getStabilityCvMeter() const noexcept { return stabilityCvMeter_.load(); }
 
 private:
+    // HQ engine hand-off. Idle: none built, the audio thread may request one.
+    // Requested: the audio thread captured warmState_, the message thread is
+    // building. Ready: the audio thread owns engineHQ_. Retired: the audio
+    // thread is done with it, the message thread frees it.
+    static constexpr int kHQIdle = 0;
+    static constexpr int kHQRequested = 1;
+    static constexpr int kHQReady = 2;
+    static constexpr int kHQRetired = 3;
+    // settingsEngine_ before any engine got settings.
+    static constexpr int kNoEngine = -2;
+
+    // Every parameter's raw value, looked up by ID once in the constructor.
+    struct ParameterPointers {
+        std::atomic<float>* mode = nullptr;
+        std::atomic<float>* irBank = nullptr;
+        std::atomic<float>* stability = nullptr;
+        std::atomic<float>* breathSync = nullptr;
+        std::atomic<float>* breathRate = nullptr;
+        std::atomic<float>* breathDepth = nullptr;
+        std::atomic<float>* cvMode = nullptr;
+        std::atomic<float>* cvAmount = nullptr;
+        std::atomic<float>* cvSmoothing = nullptr;
+        std::atomic<float>* cvFilterTime = nullptr;
+        std::atomic<float>* dry = nullptr;
+        std::atomic<float>* wet = nullptr;
+        std::atomic<float>* output = nullptr;
+        std::atomic<float>* freeze = nullptr;
+        std::atomic<float>* freezeMode = nullptr;
+        std::atomic<float>* oversampleHq = nullptr;
+        std::atomic<float>* oversampleLive = nullptr;
+        std::atomic<float>* fullTails = nullptr;
+    };
+
+    // The parameters as the audio thread uses them, rebuilt only after one
+    // changed.
+    struct ParameterSnapshot {
+        verbsuite::WeirdMode mode = verbsuite::WeirdMode::LivingSignal;
+        float stability = 0.45f;
+        float breathRateHz = 0.35f;
+        float breathDepth = 0.75f;
+        bool tempoSync = false;
+        float breathBeats = 1.0f;
+        bool wildIrBank = false;
+        bool sidechainCv = false;
+        float cvAmount = 0.0f;
+        verbsuite::CVFollowerSettings cvSettings;
+        float dry = 0.55f;
+        float wet = 0.72f;
+        float outputGain = 1.0f;
+        bool freeze = false;
+        bool momentaryFreeze = false;
+        bool fullTails = false;
+    };
+
+    void timerCallback() override;
+    // Any thread: marks the snapshot stale.
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    // Audio thread.
+    void refreshSnapshot();
+    // Oversampling factor index (0 = 2x, 1 = 4x) the parameters ask for, or -1.
+    [[nodiscard]] int wantedHQ() const;
+    // Audio thread: the HQ index that can run this block, or -1 while the
+    // wanted engine is still being built.
+    [[nodiscard]] int acquireHQ(int wanted);
+    // Not realtime-safe.
+    void buildHQEngine(int index);
+
     static verbsuite::WeirdControls controlsFromModeAndStability(
         verbsuite::WeirdMode mode,
         float stability,
@@ -56,13 +127,37 @@ private:
         bool freeze);
 
     juce::AudioProcessorValueTreeState parameters_;
+    ParameterPointers parameterPointers_;
+    ParameterSnapshot snapshot_;
+    std::atomic<bool> parametersDirty_ { true };
+    // Last settings published, the engine they went to (-1 = 1x, else the HQ
+    // index), and the host tempo they were built for.
+    verbsuite::EngineSettings settings_;
+    int settingsEngine_ = kNoEngine;
+    double settingsBpm_ = 0.0;
+    juce::SmoothedValue<float> outputGain_;
     std::unique_ptr<verbsuite::WeirdConvolutionReverb> engine_;
+    // Built only while an HQ path is on, at 2x (index 0) or 4x (index 1).
     std::unique_ptr<verbsuite::WeirdConvolutionReverb> engineHQ_;
-    std::unique_ptr<juce::dsp::Oversampling<float>> oversampling_;
+    int engineHQIndex_ = -1;
+    std::atomic<int> hqStage_ { kHQIdle };
+    int hqRequest_ = -1;
+    verbsuite::EngineWarmState warmState_;
+    verbsuite::IRSynthesisMode synthesisMode_ = verbsuite::IRSynthesisMode::Inline;
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, 2> oversampling_;
+    // Host latency of the 1x, 2x and 4x paths.
+    std::array<int, 3> pathLatency_ {};
+    int reportedLatency_ = 0;
+    int activeHQ_ = -1;
+    // Sized in prepareToPlay; longer host blocks are processed in slices.
+    int maxBlockSize_ = 0;
+    // Main-bus channels the engines run in a surround layout (all but the
+    // LFE), set in prepareToPlay; none in stereo.
+    std::array<int, verbsuite::WeirdConvolutionReverb::kMaxChannels> surroundChannels_ {};
+    std::size_t surroundChannelCount_ = 0;
+    std::array<float*, verbsuite::WeirdConvolutionReverb::kMaxChannels> channelPointers_ {};
+    verbsuite::CVFollower cvFollower_;
     std::atomic<float> stabilityCvMeter_ { 0.0f };
-    float cvEnvelopeState_ = 0.0f;
-    float cvEnvelopeHeld_ = 0.0f;
-    int cvEnvelopeStepCounter_ = 0;
     int currentProgram_ = 0;
     bool previousFreezeParam_ = false;
     int freezeMomentarySamplesRemaining_ = 0;
@@ -0,0 +1,60 @@
+#include "VerbSuite/Random.h"
+
+namespace verbsuite {
+
+void RandomStream::seed(std::uint64_t seedValue, std::uint32_t stream) noexcept {
+    std::uint64_t x = seedValue;
+    for (std::size_t i = 0; i < 4; i += 2) {
+        x += 0x9E3779B97F4A7C15ull;
+        std::uint64_t z = x;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        z ^= z >> 31;
+        state_[i] = static_cast<std::uint32_t>(z);
+        state_[i + 1] = static_cast<std::uint32_t>(z >> 32);
+    }
+    // xoshiro must not start from the all-zero state.
+    if ((state_[0] | state_[1] | state_[2] | state_[3]) == 0) {
+        state_[0] = 1;
+    }
+    for (std::uint32_t s = 0; s < stream; ++s) {
+        jump();
+    }
+}
+
+void RandomStream::jump() noexcept {
+    static constexpr std::uint32_t kJump[] = { 0x8764000bu, 0xf542d2d3u, 0x6fa035c3u, 0x77f2db5bu };
+    jumpBy(kJump);
+}
+
+void RandomStream::longJump() noexcept {
+    static constexpr std::uint32_t kLongJump[] = { 0xb523952eu, 0x0b6f099fu, 0xccf5a0efu, 0x1c580662u };
+    jumpBy(kLongJump);
+}
+
+void RandomStream::jumpBy(const std::uint32_t (&polynomial)[4]) noexcept {
+    std::uint32_t s[4] {};
+    for (const auto word : polynomial) {
+        for (int b = 0; b < 32; ++b) {
+            if (word & (1u << b)) {
+                for (int i = 0; i < 4; ++i) {
+                    s[i] ^= state_[i];
+                }
+            }
+            (void)next();
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        state_[i] = s[i];
+    }
+}
+
+void RandomStream::fill(float* out, std::size_t count) noexcept {
+    // No std::uniform_real_distribution to rebuild per draw; the loop keeps the
+    // state in registers across the whole batch.
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = uniform();
+    }
+}
+
+} // namespace verbsuite
@@ -0,0 +1,478 @@
+#include "VerbSuite/TapKernel.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define VERBSUITE_TAPS_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define VERBSUITE_TAPS_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(VERBSUITE_TAPS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define VERBSUITE_TAPS_AVX2 1
+#endif
+
+namespace verbsuite {
+namespace {
+
+// Taps gathered per pass; the direct path never uses more than ~300 taps.
+constexpr std::size_t kChunk = 64;
+
+// Gathers tap inputs [first, first + n) into x.
+using GatherFn = void (*)(const StridedTaps& taps, std::size_t first, std::size_t n, float* x);
+
+// Taps at or before zeroIndex all read the newest input sample.
+std::size_t inputDelay(const StridedTaps& taps, std::size_t k) noexcept {
+    return k > taps.zeroIndex ? k - taps.zeroIndex : 0;
+}
+
+void gatherScalar(const StridedTaps& taps, std::size_t first, std::size_t n, float* x) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t k = (first + i) * taps.stride;
+        float v = taps.input[-static_cast<std::ptrdiff_t>(inputDelay(taps, k))];
+        if (taps.feedback != nullptr) {
+            v += taps.feedback[-static_cast<std::ptrdiff_t>(k)] * taps.feedbackAmount;
+        }
+        x[i] = v;
+    }
+}
+
+// Index of the first tap past zeroIndex; from there on input delays fall by
+// `stride` per tap, which is what the vector paths exploit.
+std::size_t firstLinearTap(const StridedTaps& taps) noexcept {
+    return std::min(taps.count, (taps.zeroIndex + taps.stride) / taps.stride);
+}
+
+#if defined(VERBSUITE_TAPS_X86)
+void gatherSSE2(const StridedTaps& taps, std::size_t first, std::size_t n, float* x) {
+    const std::size_t linear = std::clamp(firstLinearTap(taps), first, first + n);
+    gatherScalar(taps, first, linear - first, x);
+
+    const auto s = static_cast<std::ptrdiff_t>(taps.stride);
+    const __m128 amount = _mm_set1_ps(taps.feedbackAmount);
+    std::size_t i = linear;
+    for (; i + 4 <= first + n; i += 4) {
+        const auto k = static_cast<std::ptrdiff_t>(i * taps.stride);
+        const float* in = taps.input - (k - static_cast<std::ptrdiff_t>(taps.zeroIndex));
+        __m128 v = _mm_setr_ps(in[0], in[-s], in[-2 * s], in[-3 * s]);
+        if (taps.feedback != nullptr) {
+            const float* fb = taps.feedback - k;
+            v = _mm_add_ps(v, _mm_mul_ps(_mm_setr_ps(fb[0], fb[-s], fb[-2 * s], fb[-3 * s]), amount));
+        }
+        _mm_storeu_ps(x + (i - first), v);
+    }
+    gatherScalar(taps, i, first + n - i, x + (i - first));
+}
+#endif
+
+#if defined(VERBSUITE_TAPS_AVX2)
+// Built from scalar loads rather than vpgatherdps: with the gather-data-sampling
+// microcode mitigation hardware gathers run several times slower than this.
+__attribute__((target("avx2"))) void gatherAVX2(const StridedTaps& taps, std::size_t first, std::size_t n, float* x) {
+    const std::size_t linear = std::clamp(firstLinearTap(taps), first, first + n);
+    gatherScalar(taps, first, linear - first, x);
+
+    const auto s = static_cast<std::ptrdiff_t>(taps.stride);
+    const __m256 amount = _mm256_set1_ps(taps.feedbackAmount);
+    std::size_t i = linear;
+    for (; i + 8 <= first + n; i += 8) {
+        const auto k = static_cast<std::ptrdiff_t>(i * taps.stride);
+        const float* in = taps.input - (k - static_cast<std::ptrdiff_t>(taps.zeroIndex));
+        __m256 v = _mm256_setr_ps(in[0], in[-s], in[-2 * s], in[-3 * s], in[-4 * s], in[-5 * s], in[-6 * s], in[-7 * s]);
+        if (taps.feedback != nullptr) {
+            const float* fb = taps.feedback - k;
+            const __m256 f = _mm256_setr_ps(fb[0], fb[-s], fb[-2 * s], fb[-3 * s], fb[-4 * s], fb[-5 * s], fb[-6 * s], fb[-7 * s]);
+            v = _mm256_add_ps(v, _mm256_mul_ps(f, amount));
+        }
+        _mm256_storeu_ps(x + (i - first), v);
+    }
+    // The rest of the library is SSE-encoded; leave the upper halves clean.
+    _mm256_zeroupper();
+    gatherSSE2(taps, i, first + n - i, x + (i - first));
+}
+
+bool cpuHasAVX2() noexcept {
+    static const bool has = __builtin_cpu_supports("avx2") != 0;
+    return has;
+}
+#endif
+
+#if defined(VERBSUITE_TAPS_NEON)
+void gatherNEON(const StridedTaps& taps, std::size_t first, std::size_t n, float* x) {
+    const std::size_t linear = std::clamp(firstLinearTap(taps), first, first + n);
+    gatherScalar(taps, first, linear - first, x);
+
+    const auto s = static_cast<std::ptrdiff_t>(taps.stride);
+    std::size_t i = linear;
+    for (; i + 4 <= first + n; i += 4) {
+        const auto k = static_cast<std::ptrdiff_t>(i * taps.stride);
+        const float* in = taps.input - (k - static_cast<std::ptrdiff_t>(taps.zeroIndex));
+        float32x4_t v = vdupq_n_f32(in[0]);
+        v = vsetq_lane_f32(in[-s], v, 1);
+        v = vsetq_lane_f32(in[-2 * s], v, 2);
+        v = vsetq_lane_f32(in[-3 * s], v, 3);
+        if (taps.feedback != nullptr) {
+            const float* fb = taps.feedback - k;
+            float32x4_t f = vdupq_n_f32(fb[0]);
+            f = vsetq_lane_f32(fb[-s], f, 1);
+            f = vsetq_lane_f32(fb[-2 * s], f, 2);
+            f = vsetq_lane_f32(fb[-3 * s], f, 3);
+            // Same single rounding the compiler gives the scalar `x += f * a`
+            // when it contracts to fused multiply-add on this target.
+            v = vfmaq_n_f32(v, f, taps.feedbackAmount);
+        }
+        vst1q_f32(x + (i - first), v);
+    }
+    gatherScalar(taps, i, first + n - i, x + (i - first));
+}
+#endif
+
+using FusedFn = void (*)(const FusedStridedTaps& taps, std::size_t n, float* wet);
+
+std::size_t bandDelay(const FusedStridedTaps& taps, std::size_t band, std::size_t k) noexcept {
+    return k > taps.zeroIndex[band] ? k - taps.zeroIndex[band] : 0;
+}
+
+// Input of tap k for one band, written exactly like the single-band loop so
+// the compiler rounds (or contracts) it the same way.
+float bandInput(const FusedStridedTaps& taps, std::size_t band, std::size_t k) noexcept {
+    float x = taps.input[-static_cast<std::ptrdiff_t>(bandDelay(taps, band, k))];
+    if (taps.feedback != nullptr) {
+        x += taps.feedback[-static_cast<std::ptrdiff_t>(k)] * taps.feedbackAmount;
+    }
+    return x;
+}
+
+// Taps [0, n) of all three bands, accumulated into wet[0..2].
+void fusedScalar(const FusedStridedTaps& taps, std::size_t n, float* wet) {
+    float low = wet[0];
+    float mid = wet[1];
+    float high = wet[2];
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t k = i * taps.stride;
+        const float* ir = taps.packedIR + i * FusedStridedTaps::kLanes;
+        low += bandInput(taps, 0, k) * ir[0];
+        mid += bandInput(taps, 1, k) * ir[1];
+        high += bandInput(taps, 2, k) * ir[2];
+    }
+    wet[0] = low;
+    wet[1] = mid;
+    wet[2] = high;
+}
+
+#if defined(VERBSUITE_TAPS_X86)
+// AVX2 gets no separate fused path: a wider vector would have to split one
+// band's sum across lanes and change its rounding.
+void fusedSSE2(const FusedStridedTaps& taps, std::size_t n, float* wet) {
+    __m128 acc = _mm_setr_ps(wet[0], wet[1], wet[2], 0.0f);
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t k = i * taps.stride;
+        __m128 x = _mm_setr_ps(taps.input[-static_cast<std::ptrdiff_t>(bandDelay(taps, 0, k))],
+            taps.input[-static_cast<std::ptrdiff_t>(bandDelay(taps, 1, k))],
+            taps.input[-static_cast<std::ptrdiff_t>(bandDelay(taps, 2, k))],
+            0.0f);
+        if (taps.feedback != nullptr) {
+            x = _mm_add_ps(x, _mm_set1_ps(taps.feedback[-static_cast<std::ptrdiff_t>(k)] * taps.feedbackAmount));
+        }
+        acc = _mm_add_ps(acc, _mm_mul_ps(x, _mm_loadu_ps(taps.packedIR + i * FusedStridedTaps::kLanes)));
+    }
+    alignas(16) float out[FusedStridedTaps::kLanes];
+    _mm_store_ps(out, acc);
+    wet[0] = out[0];
+    wet[1] = out[1];
+    wet[2] = out[2];
+}
+#endif
+
+#if defined(VERBSUITE_TAPS_NEON)
+void fusedNEON(const FusedStridedTaps& taps, std::size_t n, float* wet) {
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    acc = vsetq_lane_f32(wet[0], acc, 0);
+    acc = vsetq_lane_f32(wet[1], acc, 1);
+    acc = vsetq_lane_f32(wet[2], acc, 2);
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t k = i * taps.stride;
+        float32x4_t x = vdupq_n_f32(0.0f);
+        x = vsetq_lane_f32(taps.input[-static_cast<std::ptrdiff_t>(bandDelay(taps, 0, k))], x, 0);
+        x = vsetq_lane_f32(taps.input[-static_cast<std::ptrdiff_t>(bandDelay(taps, 1, k))], x, 1);
+        x = vsetq_lane_f32(taps.input[-static_cast<std::ptrdiff_t>(bandDelay(taps, 2, k))], x, 2);
+        if (taps.feedback != nullptr) {
+            x = vfmaq_n_f32(x, vdupq_n_f32(taps.feedback[-static_cast<std::ptrdiff_t>(k)]), taps.feedbackAmount);
+        }
+        // Fused multiply-add, as the scalar loop compiles to on this target.
+        acc = vfmaq_f32(acc, x, vld1q_f32(taps.packedIR + i * FusedStridedTaps::kLanes));
+    }
+    wet[0] = vgetq_lane_f32(acc, 0);
+    wet[1] = vgetq_lane_f32(acc, 1);
+    wet[2] = vgetq_lane_f32(acc, 2);
+}
+#endif
+
+using ChannelFn = void (*)(const ChannelStridedTaps& taps, float* wet);
+
+void channelScalar(const ChannelStridedTaps& taps, float* wet) {
+    std::fill_n(wet, taps.lanes, 0.0f);
+    const auto frameStep = static_cast<std::ptrdiff_t>(taps.stride * taps.lanes);
+    const float* x = taps.history;
+    const float* ir = taps.packedIR;
+    for (std::size_t i = 0; i < taps.count; ++i, x -= frameStep, ir += taps.lanes) {
+        for (std::size_t c = 0; c < taps.lanes; ++c) {
+            wet[c] += x[c] * ir[c];
+        }
+    }
+}
+
+// The SIMD kernels are instantiated per register count so the accumulators
+// stay in registers; channelGroups() picks the instantiation.
+template <typename Kernel>
+void channelGroups(const ChannelStridedTaps& taps, float* wet, std::size_t width) {
+    switch (taps.lanes / width) {
+    case 1: Kernel::template run<1>(taps, wet); break;
+    case 2: Kernel::template run<2>(taps, wet); break;
+    case 3: Kernel::template run<3>(taps, wet); break;
+    default: Kernel::template run<4>(taps, wet); break;
+    }
+}
+
+#if defined(VERBSUITE_TAPS_X86)
+struct ChannelSSE2 {
+    template <std::size_t Groups>
+    static void run(const ChannelStridedTaps& taps, float* wet) {
+        constexpr std::size_t kWidth = ChannelStridedTaps::kLaneWidth;
+        const auto frameStep = static_cast<std::ptrdiff_t>(taps.stride * taps.lanes);
+        __m128 acc[Groups];
+        for (std::size_t g = 0; g < Groups; ++g) {
+            acc[g] = _mm_setzero_ps();
+        }
+        const float* x = taps.history;
+        const float* ir = taps.packedIR;
+        for (std::size_t i = 0; i < taps.count; ++i, x -= frameStep, ir += taps.lanes) {
+            for (std::size_t g = 0; g < Groups; ++g) {
+                acc[g] = _mm_add_ps(acc[g], _mm_mul_ps(_mm_loadu_ps(x + g * kWidth), _mm_loadu_ps(ir + g * kWidth)));
+            }
+        }
+        for (std::size_t g = 0; g < Groups; ++g) {
+            _mm_storeu_ps(wet + g * kWidth, acc[g]);
+        }
+    }
+};
+
+void channelSSE2(const ChannelStridedTaps& taps, float* wet) {
+    channelGroups<ChannelSSE2>(taps, wet, ChannelStridedTaps::kLaneWidth);
+}
+#endif
+
+#if defined(VERBSUITE_TAPS_AVX2)
+struct ChannelAVX2 {
+    template <std::size_t Groups>
+    __attribute__((target("avx2"))) static void run(const ChannelStridedTaps& taps, float* wet) {
+        constexpr std::size_t kWidth = 2 * ChannelStridedTaps::kLaneWidth;
+        const auto frameStep = static_cast<std::ptrdiff_t>(taps.stride * taps.lanes);
+        __m256 acc[Groups];
+        for (std::size_t g = 0; g < Groups; ++g) {
+            acc[g] = _mm256_setzero_ps();
+        }
+        const float* x = taps.history;
+        const float* ir = taps.packedIR;
+        for (std::size_t i = 0; i < taps.count; ++i, x -= frameStep, ir += taps.lanes) {
+            for (std::size_t g = 0; g < Groups; ++g) {
+                acc[g] = _mm256_add_ps(acc[g], _mm256_mul_ps(_mm256_loadu_ps(x + g * kWidth), _mm256_loadu_ps(ir + g * kWidth)));
+            }
+        }
+        for (std::size_t g = 0; g < Groups; ++g) {
+            _mm256_storeu_ps(wet + g * kWidth, acc[g]);
+        }
+        _mm256_zeroupper();
+    }
+};
+
+// Lane counts that are not a whole number of AVX registers stay on SSE2.
+void channelAVX2(const ChannelStridedTaps& taps, float* wet) {
+    constexpr std::size_t kWidth = 2 * ChannelStridedTaps::kLaneWidth;
+    if (taps.lanes % kWidth != 0) {
+        channelSSE2(taps, wet);
+        return;
+    }
+    channelGroups<ChannelAVX2>(taps, wet, kWidth);
+}
+#endif
+
+#if defined(VERBSUITE_TAPS_NEON)
+struct ChannelNEON {
+    template <std::size_t Groups>
+    static void run(const ChannelStridedTaps& taps, float* wet) {
+        constexpr std::size_t kWidth = ChannelStridedTaps::kLaneWidth;
+        const auto frameStep = static_cast<std::ptrdiff_t>(taps.stride * taps.lanes);
+        float32x4_t acc[Groups];
+        for (std::size_t g = 0; g < Groups; ++g) {
+            acc[g] = vdupq_n_f32(0.0f);
+        }
+        const float* x = taps.history;
+        const float* ir = taps.packedIR;
+        for (std::size_t i = 0; i < taps.count; ++i, x -= frameStep, ir += taps.lanes) {
+            for (std::size_t g = 0; g < Groups; ++g) {
+                // Fused multiply-add, as the scalar loop compiles to on this target.
+                acc[g] = vfmaq_f32(acc[g], vld1q_f32(x + g * kWidth), vld1q_f32(ir + g * kWidth));
+            }
+        }
+        for (std::size_t g = 0; g < Groups; ++g) {
+            vst1q_f32(wet + g * kWidth, acc[g]);
+        }
+    }
+};
+
+void channelNEON(const ChannelStridedTaps& taps, float* wet) {
+    channelGroups<ChannelNEON>(taps, wet, ChannelStridedTaps::kLaneWidth);
+}
+#endif
+
+ChannelFn channelFor(TapKernel kernel) noexcept {
+    switch (kernel) {
+#if defined(VERBSUITE_TAPS_X86)
+    case TapKernel::SSE2: return channelSSE2;
+#endif
+#if defined(VERBSUITE_TAPS_AVX2)
+    case TapKernel::AVX2: return cpuHasAVX2() ? channelAVX2 : channelSSE2;
+#endif
+#if defined(VERBSUITE_TAPS_NEON)
+    case TapKernel::NEON: return channelNEON;
+#endif
+    default: return channelScalar;
+    }
+}
+
+FusedFn fusedFor(TapKernel kernel) noexcept {
+    switch (kernel) {
+#if defined(VERBSUITE_TAPS_X86)
+    case TapKernel::SSE2:
+    case TapKernel::AVX2: return fusedSSE2;
+#endif
+#if defined(VERBSUITE_TAPS_NEON)
+    case TapKernel::NEON: return fusedNEON;
+#endif
+    default: return fusedScalar;
+    }
+}
+
+GatherFn gatherFor(TapKernel kernel) noexcept {
+    switch (kernel) {
+#if defined(VERBSUITE_TAPS_X86)
+    case TapKernel::SSE2: return gatherSSE2;
+#endif
+#if defined(VERBSUITE_TAPS_AVX2)
+    case TapKernel::AVX2: return cpuHasAVX2() ? gatherAVX2 : gatherSSE2;
+#endif
+#if defined(VERBSUITE_TAPS_NEON)
+    case TapKernel::NEON: return gatherNEON;
+#endif
+    default: return gatherScalar;
+    }
+}
+
+} // namespace
+
+bool tapKernelSupported(TapKernel kernel) noexcept {
+    switch (kernel) {
+    case TapKernel::Scalar: return true;
+#if defined(VERBSUITE_TAPS_X86)
+    case TapKernel::SSE2: return true;
+#endif
+#if defined(VERBSUITE_TAPS_AVX2)
+    case TapKernel::AVX2: return cpuHasAVX2();
+#endif
+#if defined(VERBSUITE_TAPS_NEON)
+    case TapKernel::NEON: return true;
+#endif
+    default: return false;
+    }
+}
+
+TapKernel bestTapKernel() noexcept {
+    static const TapKernel best = [] {
+        for (const auto kernel : { TapKernel::AVX2, TapKernel::NEON, TapKernel::SSE2 }) {
+            if (tapKernelSupported(kernel)) {
+                return kernel;
+            }
+        }
+        return TapKernel::Scalar;
+    }();
+    return best;
+}
+
+const char* tapKernelName(TapKernel kernel) noexcept {
+    switch (kernel) {
+    case TapKernel::SSE2: return "sse2";
+    case TapKernel::AVX2: return "avx2";
+    case TapKernel::NEON: return "neon";
+    default: return "scalar";
+    }
+}
+
+float stridedTapSum(const StridedTaps& taps) noexcept {
+    return stridedTapSum(taps, bestTapKernel());
+}
+
+float stridedTapSum(const StridedTaps& taps, TapKernel kernel) noexcept {
+    const GatherFn gather = gatherFor(kernel);
+    float x[kChunk];
+    float wet = 0.0f;
+    for (std::size_t first = 0; first < taps.count; first += kChunk) {
+        const std::size_t n = std::min(kChunk, taps.count - first);
+        gather(taps, first, n, x);
+        const float* ir = taps.ir + first * taps.stride;
+        for (std::size_t i = 0; i < n; ++i) {
+            wet += x[i] * ir[i * taps.stride];
+        }
+    }
+    return wet;
+}
+
+void packStridedIRs(const std::array<const float*, FusedStridedTaps::kBands>& irs,
+    const std::array<std::size_t, FusedStridedTaps::kBands>& sizes,
+    std::size_t stride,
+    std::size_t count,
+    float* packed) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t k = i * stride;
+        float* dst = packed + i * FusedStridedTaps::kLanes;
+        for (std::size_t b = 0; b < FusedStridedTaps::kBands; ++b) {
+            dst[b] = k < sizes[b] ? irs[b][k] : 0.0f;
+        }
+        dst[FusedStridedTaps::kBands] = 0.0f;
+    }
+}
+
+void fusedTapSum(const FusedStridedTaps& taps, float* wet) noexcept {
+    fusedTapSum(taps, wet, bestTapKernel());
+}
+
+void fusedTapSum(const FusedStridedTaps& taps, float* wet, TapKernel kernel) noexcept {
+    wet[0] = 0.0f;
+    wet[1] = 0.0f;
+    wet[2] = 0.0f;
+    const std::size_t shared = std::min({ taps.count[0], taps.count[1], taps.count[2] });
+    if (tapKernelSupported(kernel)) {
+        fusedFor(kernel)(taps, shared, wet);
+    } else {
+        fusedScalar(taps, shared, wet);
+    }
+
+    // Bands with more taps than the shortest finish on their own.
+    for (std::size_t b = 0; b < FusedStridedTaps::kBands; ++b) {
+        for (std::size_t i = shared; i < taps.count[b]; ++i) {
+            wet[b] += bandInput(taps, b, i * taps.stride) * taps.packedIR[i * FusedStridedTaps::kLanes + b];
+        }
+    }
+}
+
+void channelTapSum(const ChannelStridedTaps& taps, float* wet) noexcept {
+    channelTapSum(taps, wet, bestTapKernel());
+}
+
+void channelTapSum(const ChannelStridedTaps& taps, float* wet, TapKernel kernel) noexcept {
+    channelFor(kernel)(taps, wet);
+}
+
+} // namespace verbsuite
@@ -1,29 +1,97 @@
 #include "VerbSuite/WeirdConvolutionReverb.h"
 
+#include "VerbSuite/FastMath.h"
+#include "VerbSuite/NonUniformConvolver.h"
+#include "VerbSuite/PartitionedConvolver.h"
+#include "VerbSuite/TapKernel.h"
+
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
+#include <limits>
+#include <stdexcept>
 
 namespace verbsuite {
 namespace {
 constexpr float kPi = 3.14159265358979323846f;
 
 float softClip(float x) {
-    return std::tanh(x);
+    return dspTanh(x);
 }
 
 float clamp01(float x) {
     return std::clamp(x, 0.0f, 1.0f);
 }
 
+// Rainforest Memory and Habit Room always feed the wet signal back into the
+// convolution and add a resonant tail to it.
+constexpr bool isMemoryMode(WeirdMode mode) noexcept {
+    return mode == WeirdMode::RainforestMemory || mode == WeirdMode::HabitRoom;
+}
+
+constexpr bool feedsBack(WeirdMode mode, float stability) noexcept {
+    return isMemoryMode(mode) || (1.0f - stability) > 0.7f;
+}
+
+// Longest chunk the stage buffers hold; chunks are usually cut shorter by the
+// IR update rate.
+constexpr std::size_t kStageChunk = 256;
+
+// Adds the lifetime of the scope to *slot; a null slot disables it.
+class StageTimer {
+public:
+    explicit StageTimer(double* slot)
+        : slot_(slot) {
+        if (slot_ != nullptr) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~StageTimer() {
+        if (slot_ != nullptr) {
+            *slot_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        }
+    }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+private:
+    double* slot_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Widest direct-path tap span outside Digital Failure (112 + 192 at full
+// stability).
+constexpr std::size_t kMaxDirectTaps = 304;
+
+// Frames of per-channel history in the multichannel form; the side path reads
+// back at most kMaxDirectTaps - 1 frames.
+constexpr std::size_t kChannelHistory = 512;
+// Seed of the per-channel tap signs. Fixed, so a channel's IR depends only on
+// its index.
+constexpr std::uint64_t kChannelSignSeed = 0x5EC7u;
+
+// Direct-form taps ahead of the first FFT segment of the zero-latency engine.
+constexpr std::size_t kNonUniformHeadSize = 64;
+
+std::size_t partitionSizeFor(std::size_t blockSize) {
+    std::size_t size = 64;
+    while (size < blockSize && size < 1024) {
+        size <<= 1;
+    }
+    return size;
+}
+
 } // namespace
 
 WeirdConvolutionReverb::WeirdConvolutionReverb(double sampleRate, std::size_t blockSize, WeirdMode mode)
     : sampleRate_(sampleRate),
       blockSize_(blockSize),
       mode_(mode),
-      rng_(0xC0FFEEu) {
-    buildIRBank();
+      irBank_(IRBank::forSampleRate(sampleRate)),
+      irSynth_(irBank_->irs()) {
     reset();
 }
 
@@ -56,14 +124,269 @@ void WeirdConvolutionReverb::setMode(WeirdMode newMode) {
     mode_ = newMode;
 }
 
+const std::array<float WeirdControls::*, WeirdConvolutionReverb::kSmoothedControlCount> WeirdConvolutionReverb::kSmoothedControls = {
+    &WeirdControls::memory,
+    &WeirdControls::coherence,
+    &WeirdControls::entropy,
+    &WeirdControls::resistance,
+    &WeirdControls::stability,
+    &WeirdControls::breathDepth,
+    &WeirdControls::dry,
+    &WeirdControls::wet,
+};
+
 void WeirdConvolutionReverb::setControls(const WeirdControls& newControls) {
+    const std::size_t samples = snapControls_ ? 0 : controlSmoothingSamples_;
     controls_ = newControls;
+    tickRampsActive_ = false;
+    for (std::size_t i = 0; i < kSmoothedControlCount; ++i) {
+        auto& ramp = controlRamps_[i];
+        ramp.setTarget(newControls.*kSmoothedControls[i], samples);
+        controls_.*kSmoothedControls[i] = ramp.current();
+        tickRampsActive_ = tickRampsActive_ || (i < kTickSmoothedControls && ramp.ramping());
+    }
+}
+
+bool WeirdConvolutionReverb::queueControlEvent(const ControlEvent& event) noexcept {
+    if (eventCount_ == kMaxControlEvents) {
+        return false;
+    }
+    std::size_t i = eventCount_++;
+    for (; i > 0 && events_[i - 1].offset > event.offset; --i) {
+        events_[i] = events_[i - 1];
+    }
+    events_[i] = event;
+    return true;
+}
+
+void WeirdConvolutionReverb::applyControlEvent(const ControlEvent& event) noexcept {
+    if (event.target == ControlTarget::Mode) {
+        mode_ = modeFromIndex(static_cast<int>(event.value));
+        return;
+    }
+
+    // Smoothed fields move their ramp targets, not the values heard now.
+    WeirdControls next = controls_;
+    for (std::size_t i = 0; i < kSmoothedControlCount; ++i) {
+        next.*kSmoothedControls[i] = controlRamps_[i].target();
+    }
+    const float value = event.value;
+    switch (event.target) {
+    case ControlTarget::Mode: break;
+    case ControlTarget::Memory: next.memory = value; break;
+    case ControlTarget::Coherence: next.coherence = value; break;
+    case ControlTarget::Entropy: next.entropy = value; break;
+    case ControlTarget::Resistance: next.resistance = value; break;
+    case ControlTarget::Stability: next.stability = value; break;
+    case ControlTarget::BreathRateHz: next.breathRateHz = value; break;
+    case ControlTarget::BreathDepth: next.breathDepth = value; break;
+    case ControlTarget::BreathBeats: next.breathBeats = value; break;
+    case ControlTarget::Bpm: next.bpm = value; break;
+    case ControlTarget::TempoSync: next.tempoSync = value > 0.5f; break;
+    case ControlTarget::WildIrBank: next.wildIrBank = value > 0.5f; break;
+    case ControlTarget::Freeze: next.freeze = value > 0.5f; break;
+    case ControlTarget::Wet: next.wet = value; break;
+    case ControlTarget::Dry: next.dry = value; break;
+    }
+    setControls(next);
+}
+
+void WeirdConvolutionReverb::setControlSmoothing(double seconds) noexcept {
+    controlSmoothingSamples_ = static_cast<std::size_t>(std::max(0.0, std::round(seconds * sampleRate_)));
+}
+
+void WeirdConvolutionReverb::setIRBank(std::shared_ptr<const IRBank> bank) {
+    if (!bank || bank->irs().size() != IRBank::kCoreCount + IRBank::kWildCount) {
+        throw std::invalid_argument("IR bank must hold 16 IRs");
+    }
+
+    // The worker and the backends were sized for, and read from, the old bank.
+    const IRSynthesisMode synthesis = irSynthesisMode_;
+    irWorker_.reset();
+    irSynthesisMode_ = IRSynthesisMode::Inline;
+    const bool hadPartitioned = partitionedConvolver_ != nullptr;
+    const bool hadNonUniform = nonUniformConvolver_ != nullptr;
+    const ConvolutionEngine engine = engine_;
+    convolver_ = nullptr;
+    engine_ = ConvolutionEngine::Direct;
+    partitionedConvolver_.reset();
+    nonUniformConvolver_.reset();
+
+    irBank_ = IRBank::atSampleRate(std::move(bank), sampleRate_);
+    irSynth_.setBank(irBank_->irs());
+    reset();
+
+    if (hadPartitioned) {
+        prepareConvolutionEngine(ConvolutionEngine::Partitioned);
+    }
+    if (hadNonUniform) {
+        prepareConvolutionEngine(ConvolutionEngine::NonUniform);
+    }
+    setConvolutionEngine(engine);
+    setIRSynthesisMode(synthesis);
+}
+
+void WeirdConvolutionReverb::loadIRBank(const std::string& path) {
+    setIRBank(IRBank::load(path));
+}
+
+void WeirdConvolutionReverb::setRandomSeed(std::uint64_t seed, std::uint32_t stream) {
+    seed_ = seed;
+    stream_ = stream;
+    rng_.seed(seed_, stream_);
+    pendingRng_ = workerRandomStream();
+    irSynth_.cancel();
+    if (irWorker_) {
+        irWorker_->reset(workerRandomStream());
+    }
+}
+
+void WeirdConvolutionReverb::setIRSynthesisMode(IRSynthesisMode newMode) {
+    if (newMode == irSynthesisMode_) {
+        return;
+    }
+    irSynth_.cancel();
+    irWorker_.reset();
+    irSynthesisMode_ = newMode;
+    if (synthesizesInline()) {
+        irSynth_.prepare(irCapacity_);
+    } else {
+        irSynth_.release();
+    }
+    if (newMode == IRSynthesisMode::Background) {
+        irWorker_ = std::make_unique<IRSynthesisWorker>(irBank_->irs(), irCapacity_, historySize_, workerRandomStream());
+    } else if (newMode == IRSynthesisMode::SharedPool) {
+        irWorker_ = std::make_unique<IRSynthesisWorker>(irBank_->irs(), irCapacity_, historySize_, workerRandomStream(), &IRSynthesisPool::shared());
+    }
+    if (newMode == IRSynthesisMode::Amortized) {
+        pendingIR_.prepare(irCapacity_);
+        pendingRng_ = workerRandomStream();
+    }
+}
+
+IRSynthesisMode WeirdConvolutionReverb::irSynthesisMode() const noexcept {
+    return irSynthesisMode_;
+}
+
+bool WeirdConvolutionReverb::synthesizesInline() const noexcept {
+    return irSynthesisMode_ == IRSynthesisMode::Inline || irSynthesisMode_ == IRSynthesisMode::Amortized;
+}
+
+void WeirdConvolutionReverb::prepareWarmState(EngineWarmState& state) const {
+    state.input.assign(historySize_, 0.0f);
+    state.feedback.assign(historySize_, 0.0f);
+}
+
+void WeirdConvolutionReverb::captureWarmState(EngineWarmState& state) const noexcept {
+    // The mirrored halves make the ring contiguous from the oldest sample.
+    const std::size_t n = std::min(historySize_, state.input.size());
+    const std::size_t oldest = historyWrite_ + historySize_ - n;
+    std::copy_n(inputHistory_.begin() + static_cast<std::ptrdiff_t>(oldest), n, state.input.end() - static_cast<std::ptrdiff_t>(n));
+    std::copy_n(feedbackHistory_.begin() + static_cast<std::ptrdiff_t>(oldest), n, state.feedback.end() - static_cast<std::ptrdiff_t>(n));
+    state.sampleRate = sampleRate_;
+    state.frames = frameCounter_;
+    state.featureEnvelope = featureEnvelope_;
+    state.featureBrightness = featureBrightness_;
+    state.previousMono = previousMono_;
+    state.learnedBias = learnedBias_;
+    state.autonomousDronePhase = autonomousDronePhase_;
+    state.lpState = lpState_;
+    state.hpState = hpState_;
+    state.dynamicStability = dynamicStability_;
+    state.lofiWowPhase = lofiWowPhase_;
+}
+
+void WeirdConvolutionReverb::warmStart(const EngineWarmState& state) {
+    if (state.sampleRate <= 0.0 || state.input.empty()) {
+        return;
+    }
+    // Linear interpolation back from the newest sample, which both engines
+    // line up on; anything older than the source kept stays silent.
+    const double ratio = state.sampleRate / sampleRate_;
+    const std::size_t sourceSize = state.input.size();
+    const auto resample = [&](const std::vector<float>& source, std::vector<float>& history) {
+        for (std::size_t i = 0; i < historySize_; ++i) {
+            const double age = static_cast<double>(historySize_ - 1 - i) * ratio;
+            const auto whole = static_cast<std::size_t>(age);
+            float value = 0.0f;
+            if (whole + 1 < sourceSize) {
+                const float frac = static_cast<float>(age - static_cast<double>(whole));
+                const float newer = source[sourceSize - 1 - whole];
+                const float older = source[sourceSize - 2 - whole];
+                value = newer + (older - newer) * frac;
+            }
+            history[i] = value;
+            history[i + historySize_] = value;
+        }
+    };
+    resample(state.input, inputHistory_);
+    resample(state.feedback, feedbackHistory_);
+    historyWrite_ = 0;
+
+    frameCounter_ = static_cast<std::size_t>(static_cast<double>(state.frames) / ratio);
+    featureEnvelope_ = state.featureEnvelope;
+    featureBrightness_ = state.featureBrightness;
+    previousMono_ = state.previousMono;
+    learnedBias_ = state.learnedBias;
+    autonomousDronePhase_ = state.autonomousDronePhase;
+    lpState_ = state.lpState;
+    hpState_ = state.hpState;
+    dynamicStability_ = state.dynamicStability;
+    control_.stability = dynamicStability_;
+    lofiWowPhase_ = state.lofiWowPhase;
+}
+
+void WeirdConvolutionReverb::prepareConvolutionEngine(ConvolutionEngine engine) {
+    if (engine == ConvolutionEngine::Partitioned && !partitionedConvolver_) {
+        partitionedConvolver_ = std::make_unique<PartitionedConvolver>(partitionSizeFor(blockSize_), irCapacity_);
+    } else if (engine == ConvolutionEngine::NonUniform && !nonUniformConvolver_) {
+        nonUniformConvolver_ = std::make_unique<NonUniformConvolver>(kNonUniformHeadSize, irCapacity_);
+    }
+}
+
+void WeirdConvolutionReverb::setConvolutionEngine(ConvolutionEngine newEngine) {
+    if (newEngine == engine_) {
+        return;
+    }
+    prepareConvolutionEngine(newEngine);
+    engine_ = newEngine;
+    switch (newEngine) {
+    case ConvolutionEngine::Partitioned: convolver_ = partitionedConvolver_.get(); break;
+    case ConvolutionEngine::NonUniform: convolver_ = nonUniformConvolver_.get(); break;
+    case ConvolutionEngine::Direct: convolver_ = nullptr; break;
+    }
+    if (convolver_) {
+        convolver_->reset();
+        convolverSwapBands_ = false;
+        convolver_->loadIRs(convolverBands(false));
+        convolverDirty_ = false;
+    }
+}
+
+ConvolutionEngine WeirdConvolutionReverb::convolutionEngine() const noexcept {
+    return engine_;
+}
+
+std::size_t WeirdConvolutionReverb::latencySamples() const noexcept {
+    return convolver_ ? convolver_->latencySamples() : 0;
 }
 
 void WeirdConvolutionReverb::reset() {
-    const std::size_t maxIR = 6144;
-    inputHistory_.assign(maxIR * 2, 0.0f);
-    feedbackHistory_.assign(maxIR * 2, 0.0f);
+    // Pending ramps land on their targets.
+    for (std::size_t i = 0; i < kSmoothedControlCount; ++i) {
+        auto& ramp = controlRamps_[i];
+        float& value = controls_.*kSmoothedControls[i];
+        value = ramp.ramping() ? ramp.target() : value;
+        ramp.snap(value);
+    }
+    tickRampsActive_ = false;
+    snapControls_ = true;
+
+    // Enough history for the longest bank entry's span in time at this rate.
+    const std::size_t maxIR = std::max<std::size_t>(6144, static_cast<std::size_t>(std::ceil(6144.0 * sampleRate_ / IRBank::kReferenceRate)));
+    historySize_ = maxIR * 2;
+    inputHistory_.assign(historySize_ * 2, 0.0f);
+    feedbackHistory_.assign(historySize_ * 2, 0.0f);
     historyWrite_ = 0;
     frameCounter_ = 0;
     featureEnvelope_ = 0.0f;
@@ -76,377 +399,597 @@ void WeirdConvolutionReverb::reset() {
     dynamicStability_ = controls_.stability;
     lofiHoldCounter_ = 0;
     lofiHoldPeriod_ = 1;
+    lofiHoldPhase_ = 0;
+    control_ = {};
+    control_.stability = dynamicStability_;
+    control_.lofiDepth = clamp01(0.35f + 0.45f * controls_.entropy + 0.35f * (1.0f - dynamicStability_));
     lofiInputHeld_ = 0.0f;
     lofiWetHeld_ = 0.0f;
     lofiWowPhase_ = 0.0f;
+    std::fill(channelHistory_.begin(), channelHistory_.end(), 0.0f);
+    channelWrite_ = 0;
+    channelPackedVersion_ = ~std::uint64_t { 0 };
+    channelHeld_.fill(0.0f);
+
+    const auto& bank = irBank_->irs();
+    irCapacity_ = LivingIRSynth::capacityFor(bank);
+    if (synthesizesInline()) {
+        irSynth_.prepare(irCapacity_);
+    }
+    activeIR_.prepare(irCapacity_);
+
+    activeIR_.low.assign(bank.front().begin(), bank.front().end());
+    activeIR_.mid.assign(bank[1].begin(), bank[1].end());
+    activeIR_.high.assign(bank[2].begin(), bank[2].end());
+    activeIR_.zeroIndex = 0;
+    activeIR_.events = 0;
+    packedIR_.assign(FusedStridedTaps::kLanes * kMaxDirectTaps, 0.0f);
+    stage_.prepare(kStageChunk);
+    ++irVersion_;
+    rng_.seed(seed_, stream_);
+    irSynth_.cancel();
+    pendingSamplesLeft_ = 0;
+    if (irSynthesisMode_ == IRSynthesisMode::Amortized) {
+        pendingIR_.prepare(irCapacity_);
+        pendingRng_ = workerRandomStream();
+    }
+    if (irWorker_) {
+        irWorker_->reset(workerRandomStream());
+    }
+    if (convolver_) {
+        convolver_->reset();
+        convolverSwapBands_ = false;
+        convolver_->loadIRs(convolverBands(false));
+        convolverDirty_ = false;
+    }
+}
 
-    activeIRLow_ = irBank_.front();
-    activeIRMid_ = irBank_[1];
-    activeIRHigh_ = irBank_[2];
-    zeroIndex_ = 0;
+void WeirdConvolutionReverb::StageBuffers::prepare(std::size_t size) {
+    for (auto* buffer : { &stability, &lofiDepth, &mono, &downmix, &envelope, &brightness, &low, &mid, &high, &wet, &held }) {
+        buffer->assign(size, 0.0f);
+    }
+    loFiStep.assign(size, 1.0f);
+    refresh.assign(size, 0);
+    quantizeHold.assign(size, 0);
+    frame.assign(size, 0);
 }
 
 std::string WeirdConvolutionReverb::modeName() const {
     return modeName(mode_);
 }
 
-void WeirdConvolutionReverb::buildIRBank() {
-    irBank_.clear();
-    // Core bank.
-    irBank_.push_back(generateIR(640, 0.30f, 0.30f, 0.05f));
-    irBank_.push_back(generateIR(960, 0.80f, 0.60f, 0.25f));
-    irBank_.push_back(generateIR(1408, 1.60f, 0.80f, 0.55f));
-    irBank_.push_back(generateIR(2048, 2.80f, 0.95f, 0.88f));
-    irBank_.push_back(generateMorseIR(1536, 0.40f));
-    irBank_.push_back(generateMorseIR(2048, 0.78f));
-    irBank_.push_back(generateBodyIR(1664, 1.6f));
-    irBank_.push_back(generateBodyIR(2304, 3.1f));
-
-    // Wild bank.
-    irBank_.push_back(generateIR(384, 0.10f, 0.98f, 0.98f));
-    irBank_.push_back(generateIR(3072, 5.60f, 0.25f, 0.95f));
-    irBank_.push_back(generateMorseIR(4096, 0.96f));
-    irBank_.push_back(generateBodyIR(4096, 7.2f));
-    irBank_.push_back(generateIR(819, 0.23f, 0.99f, 0.12f));
-    irBank_.push_back(generateMorseIR(1200, 0.10f));
-    irBank_.push_back(generateBodyIR(5120, 0.4f));
-    irBank_.push_back(generateIR(4608, 7.80f, 1.0f, 0.50f));
-
-    // Distort/scramble wild entries for stronger character.
-    for (std::size_t b = 8; b < irBank_.size(); ++b) {
-        auto& ir = irBank_[b];
-        for (std::size_t i = 0; i < ir.size(); ++i) {
-            if ((i % 17) == 0) {
-                ir[i] = -ir[i];
-            }
-            if ((i % 31) == 0) {
-                ir[i] *= 1.8f;
-            }
-            ir[i] = std::tanh(ir[i] * 2.8f);
-        }
-    }
+void WeirdConvolutionReverb::updateFeatureTracking(float mono) {
+    featureEnvelope_ = featureEnvelope_ * 0.993f + std::abs(mono) * 0.007f;
+    const float hf = std::abs(mono - previousMono_);
+    featureBrightness_ = featureBrightness_ * 0.986f + hf * 0.014f;
+    previousMono_ = mono;
 }
 
-std::vector<float> WeirdConvolutionReverb::generateIR(std::size_t length, float decaySeconds, float diffusion, float tone) {
-    std::vector<float> ir(length, 0.0f);
-    std::mt19937 localRng(static_cast<uint32_t>(length * 1337 + static_cast<int>(decaySeconds * 100.0f)));
-    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
-
-    const float sr = 48000.0f;
-    const float decay = std::max(0.02f, decaySeconds);
-    float lpState = 0.0f;
-
-    for (std::size_t i = 0; i < length; ++i) {
-        const float t = static_cast<float>(i) / sr;
-        const float env = std::exp(-t / decay);
-        const float excitation = noise(localRng) * (0.25f + 0.75f * diffusion);
-        const float alpha = 0.02f + 0.35f * tone;
-        lpState += alpha * (excitation - lpState);
-        const float shimmer = std::sin(2.0f * kPi * (120.0f + 1200.0f * tone) * t) * 0.07f;
-        ir[i] = env * (lpState + shimmer);
+void WeirdConvolutionReverb::updateLivingIR(const LivingIRSnapshot& snapshot) {
+    if (irSynthesisMode_ == IRSynthesisMode::Amortized) {
+        // Normally the previous job finished in the chunk before this one; it
+        // can still be running if the update rate shrank since it started.
+        if (irSynth_.busy()) {
+            irSynth_.step(std::numeric_limits<std::size_t>::max(), pendingRng_);
+            installPendingIR();
+        }
+        irSynth_.begin(snapshot, feedbackView(), pendingIR_);
+        pendingSamplesLeft_ = updateRate_;
+#if VERBSUITE_BLOCK_PROFILER
+        blockEvents_ |= blockEventBit(BlockEvent::IRUpdate);
+#endif
+        return;
     }
-
-    if (!ir.empty()) {
-        ir[0] += 1.0f;
+    if (irWorker_) {
+        // Keep the current IRs until the worker has something newer.
+        if (irWorker_->collect(activeIR_)) {
+            convolverDirty_ = true;
+            ++irVersion_;
+#if VERBSUITE_BLOCK_PROFILER
+            blockEvents_ |= activeIR_.events;
+#endif
+        }
+        // Due before the next update point needs it.
+        const auto deadline = IRSynthesisPool::Clock::now()
+            + std::chrono::duration_cast<IRSynthesisPool::Clock::duration>(std::chrono::duration<double>(static_cast<double>(updateRate_) / sampleRate_));
+        irWorker_->submit(snapshot, feedbackView(), deadline);
+#if VERBSUITE_BLOCK_PROFILER
+        blockEvents_ |= blockEventBit(BlockEvent::IRUpdate);
+#endif
+        return;
     }
-    return ir;
+    irSynth_.run(snapshot, feedbackView(), rng_, activeIR_);
+    convolverDirty_ = true;
+    ++irVersion_;
+#if VERBSUITE_BLOCK_PROFILER
+    blockEvents_ |= static_cast<std::uint8_t>(blockEventBit(BlockEvent::IRUpdate) | activeIR_.events);
+#endif
 }
 
-std::vector<float> WeirdConvolutionReverb::generateMorseIR(std::size_t length, float density) {
-    std::vector<float> ir(length, 0.0f);
-    const int step = std::max(6, static_cast<int>(64.0f - density * 52.0f));
-    for (std::size_t i = 0; i < length; ++i) {
-        const float env = std::exp(-static_cast<float>(i) / static_cast<float>(length) * 4.0f);
-        const bool gate = ((i / static_cast<std::size_t>(step)) % 5) < 2;
-        const float tone = std::sin(2.0f * kPi * (330.0f + 90.0f * density) * static_cast<float>(i) / 48000.0f);
-        ir[i] = (gate ? 0.65f : -0.18f) * env * tone;
+void WeirdConvolutionReverb::advancePendingIR(std::size_t n) {
+    // Spread what is left evenly over the samples up to the next update point;
+    // the chunk that reaches it finishes the job whatever the estimate said.
+    std::size_t budget = std::numeric_limits<std::size_t>::max();
+    if (n < pendingSamplesLeft_) {
+        budget = std::max<std::size_t>(1, (irSynth_.remainingWork() * n + pendingSamplesLeft_ - 1) / pendingSamplesLeft_);
+        pendingSamplesLeft_ -= n;
+    } else {
+        pendingSamplesLeft_ = 0;
     }
-    if (!ir.empty()) {
-        ir[0] += 0.9f;
+    if (irSynth_.step(budget, pendingRng_)) {
+        installPendingIR();
     }
-    return ir;
 }
 
-std::vector<float> WeirdConvolutionReverb::generateBodyIR(std::size_t length, float pulseHz) {
-    std::vector<float> ir(length, 0.0f);
-    for (std::size_t i = 0; i < length; ++i) {
-        const float t = static_cast<float>(i) / 48000.0f;
-        const float breath = std::max(0.0f, std::sin(2.0f * kPi * pulseHz * t));
-        const float click = (std::fmod(static_cast<float>(i), 347.0f) < 4.0f) ? 0.6f : 0.0f;
-        const float env = std::exp(-t * 2.2f);
-        ir[i] = env * (0.45f * breath + click);
-    }
-    if (!ir.empty()) {
-        ir[0] += 0.55f;
-    }
-    return ir;
+void WeirdConvolutionReverb::installPendingIR() {
+    activeIR_.low.swap(pendingIR_.low);
+    activeIR_.mid.swap(pendingIR_.mid);
+    activeIR_.high.swap(pendingIR_.high);
+    activeIR_.zeroIndex = pendingIR_.zeroIndex;
+    activeIR_.events = pendingIR_.events;
+    convolverDirty_ = true;
+    ++irVersion_;
+#if VERBSUITE_BLOCK_PROFILER
+    blockEvents_ |= activeIR_.events;
+#endif
 }
 
-std::vector<float> WeirdConvolutionReverb::morphIR(const std::vector<float>& a, const std::vector<float>& b, float t) {
-    const std::size_t n = std::max(a.size(), b.size());
-    std::vector<float> out(n, 0.0f);
-    for (std::size_t i = 0; i < n; ++i) {
-        const float av = i < a.size() ? a[i] : 0.0f;
-        const float bv = i < b.size() ? b[i] : 0.0f;
-        out[i] = av + (bv - av) * t;
-    }
-    return out;
+LivingIRSnapshot WeirdConvolutionReverb::captureIRSnapshot(std::size_t j) const {
+    LivingIRSnapshot snapshot;
+    snapshot.mode = mode_;
+    snapshot.controls = controls_;
+    snapshot.sampleRate = sampleRate_;
+    snapshot.featureEnvelope = stage_.envelope[j];
+    snapshot.featureBrightness = stage_.brightness[j];
+    snapshot.dynamicStability = stage_.stability[j];
+    snapshot.frameCounter = stage_.frame[j];
+    return snapshot;
 }
 
-void WeirdConvolutionReverb::updateFeatureTracking(float mono) {
-    featureEnvelope_ = featureEnvelope_ * 0.993f + std::abs(mono) * 0.007f;
-    const float hf = std::abs(mono - previousMono_);
-    featureBrightness_ = featureBrightness_ * 0.986f + hf * 0.014f;
-    previousMono_ = mono;
+FeedbackView WeirdConvolutionReverb::feedbackView() const {
+    return { feedbackHistory_.data(), historySize_, historyWrite_ };
 }
 
-void WeirdConvolutionReverb::updateLivingIR() {
-    const float instability = 1.0f - dynamicStability_;
-    const float movingIndexA = clamp01(featureEnvelope_ * 5.0f + controls_.entropy * 0.35f + instability * 0.2f);
-    const float movingIndexB = clamp01(featureBrightness_ * 7.5f + controls_.memory * 0.25f);
-
-    const std::size_t bankStart = controls_.wildIrBank ? 8u : 0u;
-    const std::size_t bankCount = 8u;
-
-    const auto sampleBank = [this, bankStart](float idx) {
-        const float pos = idx * static_cast<float>(bankCount - 1);
-        const std::size_t i0 = static_cast<std::size_t>(pos);
-        const std::size_t i1 = std::min(i0 + 1, bankCount - 1);
-        return morphIR(irBank_[bankStart + i0], irBank_[bankStart + i1], pos - static_cast<float>(i0));
-    };
-
-    std::vector<float> baseA = sampleBank(movingIndexA);
-    std::vector<float> baseB = sampleBank(movingIndexB);
-
-    const float modeSkew = static_cast<float>(static_cast<int>(mode_)) / static_cast<float>(modeCount() - 1);
-    const float morph = 0.5f + 0.48f * std::sin(static_cast<float>(frameCounter_) * (0.0007f + modeSkew * 0.0005f));
+float WeirdConvolutionReverb::sampleHistory(std::size_t write, int delay) const {
+    const std::size_t n = historySize_;
+    const std::size_t idx = (write + n - (static_cast<std::size_t>(std::max(delay, 0)) % n)) % n;
+    return inputHistory_[idx];
+}
 
-    activeIRMid_ = morphIR(baseA, baseB, morph);
-    activeIRLow_ = morphIR(baseA, irBank_[bankStart], 0.4f + 0.5f * controls_.memory);
-    activeIRHigh_ = morphIR(baseB, irBank_[bankStart + bankCount - 1], 0.45f + 0.45f * controls_.entropy);
+float WeirdConvolutionReverb::feedbackAmount() const {
+    const float instability = 1.0f - dynamicStability_;
+    return (0.01f + 0.25f * controls_.memory + 0.12f * instability) * (1.0f - 0.72f * controls_.resistance);
+}
 
-    applyElasticTime(activeIRLow_);
-    applyElasticTime(activeIRMid_);
-    applyElasticTime(activeIRHigh_);
+std::size_t WeirdConvolutionReverb::tapStride() const {
+    const float instability = 1.0f - dynamicStability_;
+    return std::max<std::size_t>(2, 2 + static_cast<std::size_t>(instability * 5.0f + controls_.entropy * 3.0f));
+}
 
-    applyIRModulation(activeIRLow_);
-    applyIRModulation(activeIRMid_);
-    applyIRModulation(activeIRHigh_);
+float WeirdConvolutionReverb::convolveSample(std::size_t j, float inputSample, const std::vector<float>& ir, std::size_t zeroIndex) {
+    float wet = 0.0f;
+    const std::size_t irSize = std::min(ir.size(), historySize_ - 1);
+    if (irSize == 0) {
+        return 0.0f;
+    }
 
-    applySpectralMisalignment(activeIRMid_);
-    applySpectralMisalignment(activeIRHigh_);
+    const float feedbackAmt = feedbackAmount();
+    const std::size_t tapCap = std::min<std::size_t>(irSize, 64u + static_cast<std::size_t>(dynamicStability_ * 192.0f));
+    const std::size_t stride = tapStride();
+    const bool feedback = feedsBack(WeirdMode::DigitalFailure, dynamicStability_);
+    const std::size_t write = (historyWrite_ + j) % historySize_;
 
-    if (mode_ == WeirdMode::UncannyCausality || instability > 0.6f) {
-        zeroIndex_ = std::min<std::size_t>(activeIRMid_.size() / 2, 256);
-        const std::size_t early = std::max<std::size_t>(16, activeIRMid_.size() / 5);
-        std::reverse(activeIRMid_.begin(), activeIRMid_.begin() + early);
-        if (!activeIRLow_.empty()) {
-            std::reverse(activeIRLow_.begin(), activeIRLow_.begin() + std::min<std::size_t>(activeIRLow_.size(), 48));
+    for (std::size_t k = 0; k < tapCap; k += stride) {
+        int delay = static_cast<int>(k) - static_cast<int>(zeroIndex);
+        if (delay < 0) {
+            delay = 0;
         }
-    } else {
-        zeroIndex_ = 0;
-    }
 
-    if (mode_ == WeirdMode::HabitRoom || mode_ == WeirdMode::RainforestMemory) {
-        const float learn = 0.00005f + 0.005f * instability;
-        for (std::size_t i = 0; i < activeIRMid_.size(); ++i) {
-            const float h = feedbackHistory_[(historyWrite_ + feedbackHistory_.size() - i - 1) % feedbackHistory_.size()];
-            activeIRMid_[i] += h * learn;
+        float x = sampleHistory(write, delay);
+        if (feedback) {
+            const std::size_t fi = (write + historySize_ - k - 1) % historySize_;
+            x += feedbackHistory_[fi] * feedbackAmt;
         }
-    }
 
-    if (mode_ == WeirdMode::DigitalFailure && randomUniform(0.0f, 1.0f) < controls_.entropy * 0.28f) {
-        // Blockwise broken update: leave one band stale.
-        if (randomUniform(0.0f, 1.0f) < 0.5f) {
-            activeIRLow_.assign(activeIRMid_.begin(), activeIRMid_.begin() + std::min(activeIRMid_.size(), activeIRLow_.size()));
-        } else {
-            activeIRHigh_.assign(activeIRMid_.begin(), activeIRMid_.begin() + std::min(activeIRMid_.size(), activeIRHigh_.size()));
+        if ((k % 5 == 0) && rng_.uniform() < controls_.entropy * 0.35f) {
+            continue;
         }
-    }
-}
 
-void WeirdConvolutionReverb::applyIRModulation(std::vector<float>& ir) {
-    if (ir.empty()) {
-        return;
+        wet += x * ir[k];
     }
 
-    const float instability = 1.0f - dynamicStability_;
-    const float lfo = std::sin(static_cast<float>(frameCounter_) * (0.00028f + 0.0004f * controls_.entropy));
-    const float microSpeed = 1.0f + lfo * (0.08f + 0.23f * instability);
-
-    std::vector<float> resampled(ir.size(), 0.0f);
-    for (std::size_t i = 0; i < resampled.size(); ++i) {
-        const float src = static_cast<float>(i) * microSpeed;
-        const std::size_t i0 = static_cast<std::size_t>(src);
-        const std::size_t i1 = std::min(i0 + 1, ir.size() - 1);
-        const float t = src - static_cast<float>(i0);
-        const float a = i0 < ir.size() ? ir[i0] : 0.0f;
-        const float b = i1 < ir.size() ? ir[i1] : 0.0f;
-        resampled[i] = a + (b - a) * t;
-    }
-    ir.swap(resampled);
+    return finishConvolution<WeirdMode::DigitalFailure>(j, wet, inputSample);
+}
 
-    const std::size_t grainStep = std::max<std::size_t>(4, static_cast<std::size_t>(18 - controls_.entropy * 12.0f));
-    for (std::size_t i = grainStep; i < ir.size(); i += grainStep) {
-        const std::size_t jitter = static_cast<std::size_t>(randomUniform(0.0f, 18.0f + controls_.entropy * 24.0f));
-        const std::size_t j = std::min(ir.size() - 1, i + jitter);
-        std::swap(ir[i], ir[j]);
+template <WeirdMode M>
+std::array<float, FusedStridedTaps::kBands> WeirdConvolutionReverb::convolveBands(
+    std::size_t j,
+    const std::array<float, FusedStridedTaps::kBands>& bandInput,
+    const std::array<const std::vector<float>*, FusedStridedTaps::kBands>& irs,
+    const std::array<std::size_t, FusedStridedTaps::kBands>& zeroIndex,
+    bool swapBands) {
+    const std::size_t stride = tapStride();
+    const std::size_t tapCap = 112u + static_cast<std::size_t>(dynamicStability_ * 192.0f);
+
+    std::array<std::size_t, FusedStridedTaps::kBands> sizes {};
+    for (std::size_t b = 0; b < sizes.size(); ++b) {
+        sizes[b] = std::min(irs[b]->size(), historySize_ - 1);
     }
 
-    const int bits = static_cast<int>(2 + controls_.coherence * 10.0f + dynamicStability_ * 4.0f);
-    const float q = static_cast<float>(1 << bits);
-    const int hold = 1 + static_cast<int>(controls_.entropy * 9.0f + instability * 4.0f);
-
-    for (std::size_t i = 0; i < ir.size(); ++i) {
-        if ((i % static_cast<std::size_t>(hold)) != 0) {
-            ir[i] = ir[i - (i % static_cast<std::size_t>(hold))];
+    // Repack only when the IRs, their order or the stride changed; the packed
+    // taps cover the largest cap so stability movement needs no repack.
+    if (packedVersion_ != irVersion_ || packedStride_ != stride || packedSwapBands_ != swapBands) {
+        std::array<const float*, FusedStridedTaps::kBands> data {};
+        std::size_t longest = 0;
+        for (std::size_t b = 0; b < sizes.size(); ++b) {
+            data[b] = irs[b]->data();
+            longest = std::max(longest, std::min(sizes[b], kMaxDirectTaps));
         }
+        packStridedIRs(data, sizes, stride, (longest + stride - 1) / stride, packedIR_.data());
+        packedVersion_ = irVersion_;
+        packedStride_ = stride;
+        packedSwapBands_ = swapBands;
+    }
 
-        ir[i] = std::round(ir[i] * q) / q;
+    const std::size_t write = (historyWrite_ + j) % historySize_;
+    FusedStridedTaps taps;
+    taps.input = inputHistory_.data() + write + historySize_;
+    taps.feedback = feedsBack(M, dynamicStability_) ? feedbackHistory_.data() + write + historySize_ - 1 : nullptr;
+    taps.feedbackAmount = feedbackAmount();
+    taps.packedIR = packedIR_.data();
+    taps.zeroIndex = zeroIndex;
+    taps.stride = stride;
+    for (std::size_t b = 0; b < sizes.size(); ++b) {
+        taps.count[b] = (std::min(sizes[b], tapCap) + stride - 1) / stride;
+    }
 
-        const float drive = 1.1f + 4.0f * controls_.memory + 3.0f * instability;
-        ir[i] = softClip(ir[i] * drive);
+    std::array<float, FusedStridedTaps::kBands> wet {};
+    fusedTapSum(taps, wet.data());
+    for (std::size_t b = 0; b < wet.size(); ++b) {
+        wet[b] = sizes[b] == 0 ? 0.0f : finishConvolution<M>(j, wet[b], bandInput[b]);
     }
+    return wet;
 }
 
-void WeirdConvolutionReverb::applyElasticTime(std::vector<float>& ir) {
-    if (ir.empty()) {
-        return;
+template <WeirdMode M>
+float WeirdConvolutionReverb::finishConvolution(std::size_t j, float wet, float inputSample) const {
+    wet += inputSample * 0.10f;
+    wet = softClip(wet);
+
+    if constexpr (isMemoryMode(M)) {
+        const float instability = 1.0f - dynamicStability_;
+        const float freq = 50.0f + 2100.0f * clamp01(learnedBias_ + controls_.entropy * 0.5f);
+        const float resonant = dspSin(2.0f * kPi * freq * static_cast<float>(stage_.frame[j]) / static_cast<float>(sampleRate_));
+        wet += resonant * stage_.envelope[j] * (0.03f + 0.22f * instability);
     }
 
-    float breathing = 1.0f;
+    return wet;
+}
+
+std::array<ConvolverBandIR, BandConvolver::kBands> WeirdConvolutionReverb::convolverBands(bool swapBands) const {
     const float instability = 1.0f - dynamicStability_;
-    float breathHz = std::max(0.01f, controls_.breathRateHz);
-    if (controls_.tempoSync) {
-        const float beats = std::max(0.0625f, controls_.breathBeats);
-        const float beatHz = std::max(30.0f, controls_.bpm) / 60.0f;
-        breathHz = beatHz / beats;
-    }
-    if (mode_ == WeirdMode::LivingSignal || mode_ == WeirdMode::Afterimage || mode_ == WeirdMode::HabitRoom || mode_ == WeirdMode::UncannyCausality) {
-        const float phase = 2.0f * kPi * breathHz * (static_cast<float>(frameCounter_) / static_cast<float>(sampleRate_));
-        const float lfo = 0.5f + 0.5f * std::sin(phase * (0.8f + instability * 1.8f));
-        breathing = 1.0f + (lfo * 2.0f - 1.0f) * (0.65f + 0.95f * controls_.breathDepth);
-        breathing = std::max(0.35f, breathing);
-    }
+    // The direct path only visits every stride-th tap; scale the full IR so the
+    // partitioned sum lands at roughly the same level.
+    const float gain = 1.0f / static_cast<float>(tapStride());
+    const std::size_t zero = activeIR_.zeroIndex;
+    const auto& irLow = swapBands ? activeIR_.high : activeIR_.low;
+    const auto& irHigh = swapBands ? activeIR_.low : activeIR_.high;
+    return {{
+        { irLow.data(), irLow.size(), zero / 2, gain },
+        { activeIR_.mid.data(), activeIR_.mid.size(), zero, gain },
+        { irHigh.data(), irHigh.size(), zero + static_cast<std::size_t>(instability * 48.0f), gain },
+    }};
+}
 
-    const std::size_t outSize = std::max<std::size_t>(128, static_cast<std::size_t>(static_cast<float>(ir.size()) * breathing));
-    std::vector<float> stretched(outSize, 0.0f);
+RandomStream WeirdConvolutionReverb::workerRandomStream() const {
+    RandomStream stream(seed_, stream_);
+    stream.longJump();
+    return stream;
+}
 
-    for (std::size_t i = 0; i < outSize; ++i) {
-        const float src = static_cast<float>(i) / std::max(0.001f, breathing);
-        const std::size_t i0 = std::min<std::size_t>(static_cast<std::size_t>(src), ir.size() - 1);
-        const std::size_t i1 = std::min<std::size_t>(i0 + 1, ir.size() - 1);
-        const float t = src - static_cast<float>(i0);
-        stretched[i] = ir[i0] + (ir[i1] - ir[i0]) * t;
+const std::array<WeirdConvolutionReverb::ChunkProcessor, WeirdConvolutionReverb::kModeCount> WeirdConvolutionReverb::kChunkProcessors = {
+    &WeirdConvolutionReverb::processChunk<WeirdMode::LivingSignal>,
+    &WeirdConvolutionReverb::processChunk<WeirdMode::UncannyCausality>,
+    &WeirdConvolutionReverb::processChunk<WeirdMode::SpectralGhost>,
+    &WeirdConvolutionReverb::processChunk<WeirdMode::RainforestMemory>,
+    &WeirdConvolutionReverb::processChunk<WeirdMode::ProcessImprint>,
+    &WeirdConvolutionReverb::processChunk<WeirdMode::DigitalFailure>,
+    &WeirdConvolutionReverb::processChunk<WeirdMode::AntiSpace>,
+    &WeirdConvolutionReverb::processChunk<WeirdMode::Afterimage>,
+    &WeirdConvolutionReverb::processChunk<WeirdMode::HabitRoom>,
+};
+
+void WeirdConvolutionReverb::prepareChannels(std::size_t channels) {
+    if (channels == 0 || channels > kMaxChannels) {
+        throw std::invalid_argument("channel count must be 1 to 16");
+    }
+    channelCount_ = channels;
+    constexpr std::size_t width = ChannelStridedTaps::kLaneWidth;
+    channelLanes_ = (channels + width - 1) / width * width;
+    channelHistory_.assign(kChannelHistory * 2 * channelLanes_, 0.0f);
+    channelWrite_ = 0;
+    channelIR_.assign(kMaxDirectTaps * channelLanes_, 0.0f);
+    channelPackedVersion_ = ~std::uint64_t { 0 };
+    channelHeld_.fill(0.0f);
+
+    // Random signs decorrelate the channels' tails but leave each one's
+    // spectrum and decay alone. Tap 0, the direct arrival, keeps its sign, and
+    // padding lanes stay silent.
+    channelSigns_.assign(kMaxDirectTaps * channelLanes_, 0.0f);
+    for (std::size_t c = 0; c < channels; ++c) {
+        RandomStream signs(kChannelSignSeed, static_cast<std::uint32_t>(c));
+        for (std::size_t i = 0; i < kMaxDirectTaps; ++i) {
+            channelSigns_[i * channelLanes_ + c] = (i == 0 || (signs.next() & 1u) != 0) ? 1.0f : -1.0f;
+        }
     }
+}
 
-    if ((mode_ == WeirdMode::Afterimage || mode_ == WeirdMode::SpectralGhost) && (frameCounter_ % 5 == 0)) {
-        const std::size_t start = static_cast<std::size_t>(randomUniform(0.0f, static_cast<float>(stretched.size() * 0.70f)));
-        const std::size_t len = std::min<std::size_t>(96, stretched.size() - start);
-        float hold = 0.0f;
-        for (std::size_t i = 0; i < len; ++i) {
-            hold = 0.985f * hold + 0.015f * stretched[start + i];
-            stretched[start + i] = hold;
+void WeirdConvolutionReverb::packChannelIRs(std::size_t stride) {
+    // One IR per channel: the three band IRs, each read from its zero index so
+    // tap 0 is the direct arrival, summed at the wet mix's band gains.
+    const float instability = 1.0f - dynamicStability_;
+    const std::size_t zero = activeIR_.zeroIndex;
+    const std::array<const std::vector<float>*, FusedStridedTaps::kBands> irs { &activeIR_.low, &activeIR_.mid, &activeIR_.high };
+    const std::array<std::size_t, FusedStridedTaps::kBands> zeroIndex { zero / 2, zero, zero + static_cast<std::size_t>(instability * 48.0f) };
+    constexpr std::array<float, FusedStridedTaps::kBands> gains { 0.55f, 0.95f, 1.25f };
+
+    const std::size_t count = (kMaxDirectTaps + stride - 1) / stride;
+    for (std::size_t i = 0; i < count; ++i) {
+        float tap = 0.0f;
+        for (std::size_t b = 0; b < irs.size(); ++b) {
+            const std::size_t k = i * stride + zeroIndex[b];
+            tap += k < irs[b]->size() ? gains[b] * (*irs[b])[k] : 0.0f;
+        }
+        float* dst = channelIR_.data() + i * channelLanes_;
+        const float* signs = channelSigns_.data() + i * channelLanes_;
+        for (std::size_t c = 0; c < channelLanes_; ++c) {
+            dst[c] = tap * signs[c];
         }
     }
+    channelPackedVersion_ = irVersion_;
+    channelPackedStride_ = stride;
+}
 
-    ir.swap(stretched);
+void WeirdConvolutionReverb::setControlInterval(std::size_t samples) noexcept {
+    controlInterval_ = std::max<std::size_t>(1, samples);
 }
 
-void WeirdConvolutionReverb::applySpectralMisalignment(std::vector<float>& ir) {
-    if (ir.size() < 4) {
-        return;
-    }
+void WeirdConvolutionReverb::processBlockControlRate(float* left, float* right, std::size_t numSamples, const float* controlCv, float cvAmount) {
+    blockCvControlRate_ = true;
+    processBlock(left, right, numSamples, controlCv, cvAmount);
+}
 
-    const bool doIt = (mode_ == WeirdMode::SpectralGhost || mode_ == WeirdMode::ProcessImprint || mode_ == WeirdMode::Afterimage || controls_.coherence < 0.6f);
-    if (!doIt) {
+void WeirdConvolutionReverb::processBlockControlRate(float* const* channels, std::size_t numChannels, std::size_t numSamples, const float* controlCv, float cvAmount) {
+    blockCvControlRate_ = true;
+    processBlock(channels, numChannels, numSamples, controlCv, cvAmount);
+}
+
+void WeirdConvolutionReverb::processBlock(float* const* channels, std::size_t numChannels, std::size_t numSamples, const float* stabilityCv, float cvAmount) {
+    blockChannelCount_ = std::min(numChannels, channelCount_);
+    if (blockChannelCount_ == 0) {
+        blockCvControlRate_ = false;
         return;
     }
+    // The chunks read the channels through blockChannels_ and ignore the
+    // stereo pointers.
+    blockChannels_ = channels;
+    processBlock(channels[0], channels[0], numSamples, stabilityCv, cvAmount);
+    blockChannels_ = nullptr;
+}
 
-    const float instability = 1.0f - dynamicStability_;
-    const float rot = 0.03f + 0.9f * (1.0f - controls_.coherence) + 0.5f * instability;
-    for (std::size_t i = 2; i < ir.size(); ++i) {
-        const float a = ir[i];
-        const float b = ir[i - 1];
-        ir[i] = a * std::cos(rot) - b * std::sin(rot);
+void WeirdConvolutionReverb::processBlock(float* left, float* right, std::size_t numSamples, const float* stabilityCv, float cvAmount) {
+    if (controlBlock_.consume(inbox_)) {
+        setMode(inbox_.mode);
+        setControls(inbox_.controls);
     }
+    blockCv_ = stabilityCv;
+    blockCvAmount_ = cvAmount;
+    blockSamples_ = numSamples;
+#if VERBSUITE_BLOCK_PROFILER
+    const std::uint64_t blockStart = profiler_ != nullptr ? readCycleCounter() : 0;
+    blockEvents_ = 0;
+#endif
+    const std::size_t baseRate = std::max<std::size_t>(16, blockSize_ / 2);
+    std::size_t updateRate = 0;
+    ChunkProcessor process = nullptr;
+    bool modeSettled = false;
+
+    std::size_t event = 0;
+    std::size_t offset = 0;
+    while (offset < numSamples) {
+        if (event < eventCount_ && events_[event].offset <= offset) {
+            while (event < eventCount_ && events_[event].offset <= offset) {
+                applyControlEvent(events_[event++]);
+            }
+            control_.samplesLeft = 0;
+            modeSettled = false;
+        }
+        if (!modeSettled) {
+            // The mode only changes at events: pick its stage instantiations
+            // once per run between them.
+            updateRate = (mode_ == WeirdMode::DigitalFailure)
+                ? std::max<std::size_t>(24, baseRate * 8)
+                : baseRate;
+            updateRate_ = updateRate;
+            process = kChunkProcessors[static_cast<std::size_t>(mode_)];
+            modeSettled = true;
+        }
 
-    for (std::size_t i = 0; i < ir.size(); i += 8) {
-        if (randomUniform(0.0f, 1.0f) < controls_.entropy * (0.2f + 0.5f * instability)) {
-            ir[i] = -ir[i];
+        // Chunks end right before the next IR update, so an update only ever
+        // lands on a chunk's first sample and the whole chunk hears one IR.
+        // They also end right before the next event.
+        std::size_t n = std::min(numSamples - offset, kStageChunk);
+        if (event < eventCount_) {
+            n = std::min<std::size_t>(n, events_[event].offset - offset);
+        }
+        bool updateFirst = false;
+        if (!controls_.freeze) {
+            const std::size_t phase = frameCounter_ % updateRate;
+            updateFirst = phase == 0;
+            n = std::min(n, updateFirst ? updateRate : updateRate - phase);
         }
+        (this->*process)(left + offset, right + offset, offset, n, updateFirst);
+        offset += n;
     }
+    while (event < eventCount_) {
+        applyControlEvent(events_[event++]);
+    }
+    eventCount_ = 0;
+    blockCvControlRate_ = false;
+    snapControls_ = false;
+
+#if VERBSUITE_BLOCK_PROFILER
+    if (profiler_ != nullptr) {
+        BlockRecord record;
+        record.cycles = readCycleCounter() - blockStart;
+        record.samples = static_cast<std::uint32_t>(numSamples);
+        record.mode = mode_;
+        record.events = blockEvents_;
+        record.stability = controls_.stability;
+        profiler_->push(record);
+    }
+#endif
 }
 
-float WeirdConvolutionReverb::sampleHistory(int delay) const {
-    const std::size_t n = inputHistory_.size();
-    const std::size_t idx = (historyWrite_ + n - (static_cast<std::size_t>(std::max(delay, 0)) % n)) % n;
-    return inputHistory_[idx];
-}
-
-float WeirdConvolutionReverb::convolveSample(float inputSample, const std::vector<float>& ir, std::size_t zeroIndex) {
-    float wet = 0.0f;
-    const std::size_t irSize = std::min(ir.size(), inputHistory_.size() - 1);
-    if (irSize == 0) {
-        return 0.0f;
+template <WeirdMode M>
+void WeirdConvolutionReverb::processChunk(float* left, float* right, std::size_t blockOffset, std::size_t n, bool updateFirst) {
+    if (blockChannels_ != nullptr) {
+        // The shared path hears the channels' mean as both its inputs.
+        const float scale = 1.0f / static_cast<float>(blockChannelCount_);
+        for (std::size_t j = 0; j < n; ++j) {
+            float sum = 0.0f;
+            for (std::size_t c = 0; c < blockChannelCount_; ++c) {
+                sum += blockChannels_[c][blockOffset + j];
+            }
+            stage_.downmix[j] = sum * scale;
+        }
+        left = stage_.downmix.data();
+        right = left;
+    }
+    {
+        const StageTimer timer(timingEnabled_ ? &timings_.input : nullptr);
+        runInputStage<M>(left, right, blockOffset, n);
+    }
+    if (updateFirst || irSynth_.busy()) {
+        const StageTimer timer(timingEnabled_ ? &timings_.irUpdate : nullptr);
+        if (updateFirst) {
+            updateLivingIR(captureIRSnapshot(0));
+        }
+        if (irSynth_.busy()) {
+            advancePendingIR(n);
+        }
+    }
+    {
+        const StageTimer timer(timingEnabled_ ? &timings_.bandSplit : nullptr);
+        runBandSplitStage(n);
     }
 
-    const float instability = 1.0f - dynamicStability_;
-    const float feedbackAmt = (0.01f + 0.25f * controls_.memory + 0.12f * instability) * (1.0f - 0.72f * controls_.resistance);
-    const std::size_t tapCap = std::min<std::size_t>(
-        irSize,
-        (mode_ == WeirdMode::DigitalFailure ? 64u : 112u) + static_cast<std::size_t>(dynamicStability_ * 192.0f));
-    const std::size_t stride = std::max<std::size_t>(2, 2 + static_cast<std::size_t>(instability * 5.0f + controls_.entropy * 3.0f));
+    // Feedback makes each sample's convolution read the previous sample's
+    // output, Digital Failure draws from one RNG in both the convolution and
+    // quantize stages, and the resonant Rainforest/Habit tail reads the learned
+    // bias the texture stage updates. Those chunks run the stages sample by
+    // sample; everything else runs each stage across the whole chunk.
+    bool serial = M == WeirdMode::DigitalFailure || isMemoryMode(M);
+    for (std::size_t j = 0; j < n && !serial; ++j) {
+        serial = feedsBack(M, stage_.stability[j]);
+    }
 
-    for (std::size_t k = 0; k < tapCap; k += stride) {
-        int delay = static_cast<int>(k) - static_cast<int>(zeroIndex);
-        if (delay < 0) {
-            delay = 0;
+    const std::size_t step = serial ? 1 : n;
+    for (std::size_t begin = 0; begin < n; begin += step) {
+        const std::size_t end = begin + step;
+        {
+            const StageTimer timer(timingEnabled_ ? &timings_.convolution : nullptr);
+            runConvolutionStage<M>(begin, end);
         }
-
-        float x = sampleHistory(delay);
-        if (mode_ == WeirdMode::RainforestMemory || mode_ == WeirdMode::HabitRoom || instability > 0.7f) {
-            const std::size_t fi = (historyWrite_ + feedbackHistory_.size() - k - 1) % feedbackHistory_.size();
-            x += feedbackHistory_[fi] * feedbackAmt;
+        {
+            const StageTimer timer(timingEnabled_ ? &timings_.texture : nullptr);
+            runTextureStage<M>(begin, end);
         }
-
-        if (mode_ == WeirdMode::DigitalFailure && (k % 5 == 0) && randomUniform(0.0f, 1.0f) < controls_.entropy * 0.35f) {
-            continue;
+        {
+            const StageTimer timer(timingEnabled_ ? &timings_.quantize : nullptr);
+            runQuantizeStage<M>(begin, end);
+        }
+        {
+            const StageTimer timer(timingEnabled_ ? &timings_.output : nullptr);
+            if (blockChannels_ != nullptr) {
+                runChannelStage<M>(blockOffset, begin, end);
+            } else {
+                runOutputStage<M>(left, right, blockOffset, begin, end);
+            }
         }
-
-        wet += x * ir[k];
     }
 
-    wet += inputSample * 0.10f;
-    wet = softClip(wet);
-
-    if (mode_ == WeirdMode::RainforestMemory || mode_ == WeirdMode::HabitRoom) {
-        const float freq = 50.0f + 2100.0f * clamp01(learnedBias_ + controls_.entropy * 0.5f);
-        const float resonant = std::sin(2.0f * kPi * freq * static_cast<float>(frameCounter_) / static_cast<float>(sampleRate_));
-        wet += resonant * featureEnvelope_ * (0.03f + 0.22f * instability);
+    historyWrite_ = (historyWrite_ + n) % historySize_;
+    if (blockChannels_ != nullptr) {
+        channelWrite_ = (channelWrite_ + n) % kChannelHistory;
+    }
+    if (timingEnabled_) {
+        timings_.samples += n;
     }
-
-    return wet;
 }
 
-float WeirdConvolutionReverb::randomUniform(float lo, float hi) {
-    std::uniform_real_distribution<float> dist(lo, hi);
-    return dist(rng_);
+template <WeirdMode M>
+void WeirdConvolutionReverb::beginControlInterval(std::size_t blockSample) {
+    // Intervals restart with each block, so the last one may be short.
+    const std::size_t length = std::min(controlInterval_, blockSamples_ - blockSample);
+    if (tickRampsActive_) {
+        // Smoothed controls jump to where they will be at the interval's end;
+        // the values derived from them ramp there below.
+        tickRampsActive_ = false;
+        for (std::size_t i = 0; i < kTickSmoothedControls; ++i) {
+            controls_.*kSmoothedControls[i] = controlRamps_[i].skip(length);
+            tickRampsActive_ = tickRampsActive_ || controlRamps_[i].ramping();
+        }
+    }
+
+    float cv = 0.0f;
+    if (blockCv_ != nullptr) {
+        cv = blockCvControlRate_ ? blockCv_[blockSample / controlInterval_] : blockCv_[blockSample];
+    }
+    const float stability = clamp01(controls_.stability + blockCvAmount_ * cv);
+    const float lofiDepth = clamp01(0.35f + 0.45f * controls_.entropy + 0.35f * (1.0f - stability));
+
+    const float scale = 1.0f / static_cast<float>(length);
+    control_.stabilityTarget = stability;
+    control_.stabilityStep = (stability - control_.stability) * scale;
+    control_.lofiDepthTarget = lofiDepth;
+    control_.lofiDepthStep = (lofiDepth - control_.lofiDepth) * scale;
+    control_.samplesLeft = length;
+
+    const std::size_t holdPeriod = 1 + static_cast<std::size_t>(lofiDepth * (M == WeirdMode::DigitalFailure ? 22.0f : 12.0f));
+    if (holdPeriod != lofiHoldPeriod_) {
+        lofiHoldPeriod_ = holdPeriod;
+        lofiHoldPhase_ = lofiHoldCounter_ % holdPeriod;
+    }
+    const std::size_t quantizePeriod = 2 + static_cast<std::size_t>(lofiDepth * 6.0f);
+    if (blockSample == 0 || quantizePeriod != control_.quantizePeriod) {
+        control_.quantizePeriod = quantizePeriod;
+        control_.quantizePhase = blockSample % quantizePeriod;
+    }
+    control_.loFiStep = 1.0f / (6.0f + controls_.coherence * 10.0f + stability * 8.0f);
 }
 
-void WeirdConvolutionReverb::processBlock(float* left, float* right, std::size_t numSamples, const float* stabilityCv, float cvAmount) {
-    for (std::size_t i = 0; i < numSamples; ++i) {
-        const float cv = stabilityCv != nullptr ? stabilityCv[i] : 0.0f;
-        dynamicStability_ = clamp01(controls_.stability + cvAmount * cv);
-        const float instability = 1.0f - dynamicStability_;
+template <WeirdMode M>
+void WeirdConvolutionReverb::runInputStage(const float* left, const float* right, std::size_t blockOffset, std::size_t n) {
+    for (std::size_t j = 0; j < n; ++j) {
+        if (control_.samplesLeft == 0) {
+            beginControlInterval<M>(blockOffset + j);
+        }
+        if (--control_.samplesLeft == 0) {
+            control_.stability = control_.stabilityTarget;
+            control_.lofiDepth = control_.lofiDepthTarget;
+        } else {
+            control_.stability += control_.stabilityStep;
+            control_.lofiDepth += control_.lofiDepthStep;
+        }
+        dynamicStability_ = control_.stability;
+        const float lofiDepth = control_.lofiDepth;
 
-        const float inL = left[i];
-        const float inR = right[i];
-        const float monoIn = 0.5f * (inL + inR);
+        const float monoIn = 0.5f * (left[j] + right[j]);
 
-        const float lofiDepth = clamp01(0.35f + 0.45f * controls_.entropy + 0.35f * instability);
-        lofiHoldPeriod_ = 1 + static_cast<std::size_t>(lofiDepth * (mode_ == WeirdMode::DigitalFailure ? 22.0f : 12.0f));
-        const bool refreshLoFiFrame = (lofiHoldCounter_++ % lofiHoldPeriod_) == 0;
+        const bool refreshLoFiFrame = lofiHoldPhase_ == 0;
+        ++lofiHoldCounter_;
+        lofiHoldPhase_ = lofiHoldPhase_ + 1 == lofiHoldPeriod_ ? 0 : lofiHoldPhase_ + 1;
         if (refreshLoFiFrame && !controls_.freeze) {
             lofiInputHeld_ = monoIn;
         }
@@ -455,68 +998,143 @@ void WeirdConvolutionReverb::processBlock(float* left, float* right, std::size_t
         if (lofiWowPhase_ > 1.0f) {
             lofiWowPhase_ -= 1.0f;
         }
-        const float wow = std::sin(2.0f * kPi * lofiWowPhase_);
+        const float wow = dspSin(2.0f * kPi * lofiWowPhase_);
         const float mono = lofiInputHeld_ * (1.0f + wow * (0.02f + 0.06f * lofiDepth));
-        if (controls_.freeze) {
-            inputHistory_[historyWrite_] *= 0.998f;
-        } else {
-            inputHistory_[historyWrite_] = mono;
-        }
+        const std::size_t write = (historyWrite_ + j) % historySize_;
+        const float historyIn = controls_.freeze ? inputHistory_[write] * 0.998f : mono;
+        inputHistory_[write] = historyIn;
+        inputHistory_[write + historySize_] = historyIn;
 
         updateFeatureTracking(mono);
-
-        const std::size_t baseRate = std::max<std::size_t>(16, blockSize_ / 2);
-        const std::size_t updateRate = (mode_ == WeirdMode::DigitalFailure)
-            ? std::max<std::size_t>(24, baseRate * 8)
-            : baseRate;
-        if (!controls_.freeze && (frameCounter_++ % updateRate) == 0) {
-            updateLivingIR();
+        if (!controls_.freeze) {
+            ++frameCounter_;
         }
 
-        // Three-band split: different IRs can occupy different spaces.
+        stage_.stability[j] = dynamicStability_;
+        stage_.lofiDepth[j] = lofiDepth;
+        stage_.refresh[j] = refreshLoFiFrame ? 1 : 0;
+        stage_.loFiStep[j] = control_.loFiStep;
+        stage_.quantizeHold[j] = control_.quantizePhase != 0 ? 1 : 0;
+        control_.quantizePhase = control_.quantizePhase + 1 == control_.quantizePeriod ? 0 : control_.quantizePhase + 1;
+        stage_.mono[j] = mono;
+        stage_.envelope[j] = featureEnvelope_;
+        stage_.brightness[j] = featureBrightness_;
+        stage_.frame[j] = frameCounter_;
+    }
+}
+
+void WeirdConvolutionReverb::runBandSplitStage(std::size_t n) {
+    // Three-band split: different IRs can occupy different spaces.
+    for (std::size_t j = 0; j < n; ++j) {
+        const float mono = stage_.mono[j];
         lpState_ += 0.08f * (mono - lpState_);
         const float low = lpState_;
         const float hpIn = mono - lpState_;
         hpState_ += 0.04f * (hpIn - hpState_);
         const float high = hpIn - hpState_;
-        const float mid = mono - low - high;
-
-        std::size_t lowZero = zeroIndex_ / 2;
-        std::size_t midZero = zeroIndex_;
-        std::size_t highZero = zeroIndex_ + static_cast<std::size_t>(instability * 48.0f);
+        stage_.low[j] = low;
+        stage_.mid[j] = mono - low - high;
+        stage_.high[j] = high;
+    }
+}
 
-        const bool swapBands = (mode_ == WeirdMode::SpectralGhost || mode_ == WeirdMode::ProcessImprint)
-            && (((frameCounter_ / 1024) % 2) == 0);
-        const auto& irLow = swapBands ? activeIRHigh_ : activeIRLow_;
-        const auto& irHigh = swapBands ? activeIRLow_ : activeIRHigh_;
+template <WeirdMode M>
+void WeirdConvolutionReverb::runConvolutionStage(std::size_t begin, std::size_t end) {
+    for (std::size_t j = begin; j < end; ++j) {
+        dynamicStability_ = stage_.stability[j];
+        const float instability = 1.0f - dynamicStability_;
+        const float low = stage_.low[j];
+        const float mid = stage_.mid[j];
+        const float high = stage_.high[j];
+
+        std::size_t lowZero = activeIR_.zeroIndex / 2;
+        std::size_t midZero = activeIR_.zeroIndex;
+        std::size_t highZero = activeIR_.zeroIndex + static_cast<std::size_t>(instability * 48.0f);
+
+        const bool swapBands = (M == WeirdMode::SpectralGhost || M == WeirdMode::ProcessImprint)
+            && (((stage_.frame[j] / 1024) % 2) == 0);
+        const auto& irLow = swapBands ? activeIR_.high : activeIR_.low;
+        const auto& irHigh = swapBands ? activeIR_.low : activeIR_.high;
+
+        std::array<float, BandConvolver::kBands> partitioned {};
+        if (convolver_) {
+            if (swapBands != convolverSwapBands_) {
+                convolverSwapBands_ = swapBands;
+                convolverDirty_ = true;
+            }
+            if (convolverDirty_ && convolver_->readyForIRs()) {
+                convolver_->setIRs(convolverBands(swapBands));
+                convolverDirty_ = false;
+            }
+            const std::size_t write = (historyWrite_ + j) % historySize_;
+            float input = inputHistory_[write];
+            if (feedsBack(M, dynamicStability_)) {
+                const std::size_t fi = (write + historySize_ - 1) % historySize_;
+                input += feedbackHistory_[fi] * feedbackAmount();
+            }
+            convolver_->process(input, partitioned.data());
+        }
 
         float wet = lofiWetHeld_;
-        if (refreshLoFiFrame && !controls_.freeze) {
-            const float wetLow = convolveSample(low, irLow, lowZero);
-            const float wetMid = convolveSample(mid, activeIRMid_, midZero);
-            const float wetHigh = convolveSample(high, irHigh, highZero);
+        if (stage_.refresh[j] != 0 && !controls_.freeze) {
+            float wetLow = 0.0f;
+            float wetMid = 0.0f;
+            float wetHigh = 0.0f;
+            if (convolver_) {
+                wetLow = finishConvolution<M>(j, partitioned[0], low);
+                wetMid = finishConvolution<M>(j, partitioned[1], mid);
+                wetHigh = finishConvolution<M>(j, partitioned[2], high);
+            } else if constexpr (M != WeirdMode::DigitalFailure) {
+                const auto fused = convolveBands<M>(j, { low, mid, high }, { &irLow, &activeIR_.mid, &irHigh }, { lowZero, midZero, highZero }, swapBands);
+                wetLow = fused[0];
+                wetMid = fused[1];
+                wetHigh = fused[2];
+            } else {
+                wetLow = convolveSample(j, low, irLow, lowZero);
+                wetMid = convolveSample(j, mid, activeIR_.mid, midZero);
+                wetHigh = convolveSample(j, high, irHigh, highZero);
+            }
             wet = 0.55f * wetLow + 0.95f * wetMid + 1.25f * wetHigh;
             lofiWetHeld_ = wet;
         }
+        stage_.wet[j] = wet;
+        stage_.held[j] = lofiWetHeld_;
+    }
+}
+
+template <WeirdMode M>
+void WeirdConvolutionReverb::runTextureStage(std::size_t begin, std::size_t end) {
+    for (std::size_t j = begin; j < end; ++j) {
+        const float instability = 1.0f - stage_.stability[j];
+        float wet = stage_.wet[j];
 
-        if (mode_ == WeirdMode::Afterimage || mode_ == WeirdMode::HabitRoom) {
-            learnedBias_ = 0.998f * learnedBias_ + 0.002f * clamp01(featureBrightness_ * 16.0f + featureEnvelope_ * 3.0f);
-            const float residue = std::sin(2.0f * kPi * (140.0f + learnedBias_ * 1600.0f) * static_cast<float>(frameCounter_) / static_cast<float>(sampleRate_));
+        if constexpr (M == WeirdMode::Afterimage || M == WeirdMode::HabitRoom) {
+            learnedBias_ = 0.998f * learnedBias_ + 0.002f * clamp01(stage_.brightness[j] * 16.0f + stage_.envelope[j] * 3.0f);
+            const float residue = dspSin(2.0f * kPi * (140.0f + learnedBias_ * 1600.0f) * static_cast<float>(stage_.frame[j]) / static_cast<float>(sampleRate_));
             wet += residue * (0.01f + 0.12f * controls_.memory * instability);
         }
 
-        if (instability > 0.75f || mode_ == WeirdMode::HabitRoom) {
-            autonomousDronePhase_ += (0.0006f + 0.0022f * controls_.entropy + 0.001f * featureEnvelope_);
+        if (M == WeirdMode::HabitRoom || instability > 0.75f) {
+            autonomousDronePhase_ += (0.0006f + 0.0022f * controls_.entropy + 0.001f * stage_.envelope[j]);
             if (autonomousDronePhase_ > 1.0f) {
                 autonomousDronePhase_ -= 1.0f;
             }
-            const float drone = std::sin(2.0f * kPi * autonomousDronePhase_)
-                + 0.35f * std::sin(2.0f * kPi * autonomousDronePhase_ * 2.618f);
+            const float drone = dspSin(2.0f * kPi * autonomousDronePhase_)
+                + 0.35f * dspSin(2.0f * kPi * autonomousDronePhase_ * 2.618f);
             wet += drone * 0.08f * instability;
         }
+        stage_.wet[j] = wet;
+    }
+}
 
-        if (mode_ == WeirdMode::DigitalFailure) {
-            if (randomUniform(0.0f, 1.0f) < controls_.entropy * 0.02f) {
+template <WeirdMode M>
+void WeirdConvolutionReverb::runQuantizeStage(std::size_t begin, std::size_t end) {
+    for (std::size_t j = begin; j < end; ++j) {
+        dynamicStability_ = stage_.stability[j];
+        float wet = stage_.wet[j];
+
+        if constexpr (M == WeirdMode::DigitalFailure) {
+            if (rng_.uniform() < controls_.entropy * 0.02f) {
                 wet = -wet;
             }
             const float step = 1.0f / (3.0f + controls_.coherence * 12.0f);
@@ -524,33 +1142,133 @@ void WeirdConvolutionReverb::processBlock(float* left, float* right, std::size_t
         }
 
         // Intentional low-rate zippering + dynamic bit-depth drift as part of the aesthetic.
-        const float loFiStep = 1.0f / (6.0f + controls_.coherence * 10.0f + dynamicStability_ * 8.0f);
-        if ((i % (2 + static_cast<std::size_t>(lofiDepth * 6.0f))) != 0) {
-            wet = lofiWetHeld_;
+        const float loFiStep = stage_.loFiStep[j];
+        if (stage_.quantizeHold[j] != 0) {
+            wet = stage_.held[j];
         }
-        wet = std::round(wet / loFiStep) * loFiStep;
+        stage_.wet[j] = std::round(wet / loFiStep) * loFiStep;
+    }
+}
+
+template <WeirdMode M>
+void WeirdConvolutionReverb::runOutputStage(float* left, float* right, std::size_t blockOffset, std::size_t begin, std::size_t end) {
+    for (std::size_t j = begin; j < end; ++j) {
+        const float instability = 1.0f - stage_.stability[j];
+        const float inL = left[j];
+        const float inR = right[j];
+        const float wet = stage_.wet[j];
 
-        float outL = controls_.dry * inL + controls_.wet * wet;
-        float outR = controls_.dry * inR + controls_.wet * wet;
+        const float dryGain = controlRamps_[kTickSmoothedControls].next();
+        const float wetGain = controlRamps_[kTickSmoothedControls + 1].next();
+        float outL = dryGain * inL + wetGain * wet;
+        float outR = dryGain * inR + wetGain * wet;
 
-        if (mode_ == WeirdMode::AntiSpace) {
+        if constexpr (M == WeirdMode::AntiSpace) {
             const float wide = std::abs(inL - inR);
             const float collapse = clamp01(1.0f - wide * 4.3f - instability * 0.3f);
             const float monoWet = 0.5f * (outL + outR);
             outL = monoWet + (outL - monoWet) * collapse * (0.12f + 0.88f * controls_.coherence);
             outR = monoWet + (outR - monoWet) * collapse * (0.12f + 0.88f * controls_.coherence);
 
-            if (i < 96) {
+            if (blockOffset + j < 96) {
                 const float pan = 0.25f + 0.5f * controls_.entropy;
                 outL += inR * pan;
                 outR += inL * pan;
             }
         }
 
-        left[i] = softClip(outL);
-        right[i] = softClip(outR);
-        feedbackHistory_[historyWrite_] = wet;
-        historyWrite_ = (historyWrite_ + 1) % inputHistory_.size();
+        left[j] = softClip(outL);
+        right[j] = softClip(outR);
+        const std::size_t write = (historyWrite_ + j) % historySize_;
+        feedbackHistory_[write] = wet;
+        feedbackHistory_[write + historySize_] = wet;
+    }
+}
+
+template <WeirdMode M>
+void WeirdConvolutionReverb::runChannelStage(std::size_t blockOffset, std::size_t begin, std::size_t end) {
+    const std::size_t channels = blockChannelCount_;
+    const std::size_t lanes = channelLanes_;
+    std::array<float, kMaxChannels> in {};
+    std::array<float, kMaxChannels> out {};
+    alignas(32) std::array<float, kMaxChannels> sums {};
+
+    for (std::size_t j = begin; j < end; ++j) {
+        dynamicStability_ = stage_.stability[j];
+        const float instability = 1.0f - dynamicStability_;
+        const float mean = stage_.downmix[j];
+
+        // Each channel's difference from the mean; frozen histories decay as
+        // the shared one does.
+        const std::size_t frame = (channelWrite_ + j) % kChannelHistory;
+        float* slot = channelHistory_.data() + frame * lanes;
+        float* mirror = slot + kChannelHistory * lanes;
+        for (std::size_t c = 0; c < channels; ++c) {
+            in[c] = blockChannels_[c][blockOffset + j];
+            const float side = controls_.freeze ? slot[c] * 0.998f : in[c] - mean;
+            slot[c] = side;
+            mirror[c] = side;
+        }
+
+        // Refreshed with the shared wet, so the lo-fi hold spares the side
+        // path as much work as it does the shared one.
+        if (stage_.refresh[j] != 0 && !controls_.freeze) {
+            const std::size_t stride = tapStride();
+            if (channelPackedVersion_ != irVersion_ || channelPackedStride_ != stride) {
+                packChannelIRs(stride);
+            }
+            const std::size_t tapCap = 112u + static_cast<std::size_t>(dynamicStability_ * 192.0f);
+            ChannelStridedTaps taps;
+            taps.history = mirror;
+            taps.packedIR = channelIR_.data();
+            taps.lanes = lanes;
+            taps.stride = stride;
+            taps.count = (std::min(tapCap, kMaxDirectTaps) + stride - 1) / stride;
+            channelTapSum(taps, sums.data());
+            for (std::size_t c = 0; c < channels; ++c) {
+                channelHeld_[c] = softClip(sums[c] + mirror[c] * 0.10f);
+            }
+        }
+
+        const float wet = stage_.wet[j];
+        const float loFiStep = stage_.loFiStep[j];
+        const float dryGain = controlRamps_[kTickSmoothedControls].next();
+        const float wetGain = controlRamps_[kTickSmoothedControls + 1].next();
+        for (std::size_t c = 0; c < channels; ++c) {
+            const float sideWet = std::round(channelHeld_[c] / loFiStep) * loFiStep;
+            out[c] = dryGain * in[c] + wetGain * (wet + sideWet);
+        }
+
+        if constexpr (M == WeirdMode::AntiSpace) {
+            // The stereo collapse and cross-feed, over every channel: width is
+            // the widest spread from the mean, and each channel takes the next
+            // one's input.
+            float wide = 0.0f;
+            float outSum = 0.0f;
+            for (std::size_t c = 0; c < channels; ++c) {
+                wide = std::max(wide, std::abs(in[c] - mean));
+                outSum += out[c];
+            }
+            const float collapse = clamp01(1.0f - 2.0f * wide * 4.3f - instability * 0.3f);
+            const float monoWet = outSum * (1.0f / static_cast<float>(channels));
+            for (std::size_t c = 0; c < channels; ++c) {
+                out[c] = monoWet + (out[c] - monoWet) * collapse * (0.12f + 0.88f * controls_.coherence);
+            }
+
+            if (blockOffset + j < 96) {
+                const float pan = 0.25f + 0.5f * controls_.entropy;
+                for (std::size_t c = 0; c < channels; ++c) {
+                    out[c] += in[(c + 1) % channels] * pan;
+                }
+            }
+        }
+
+        for (std::size_t c = 0; c < channels; ++c) {
+            blockChannels_[c][blockOffset + j] = softClip(out[c]);
+        }
+        const std::size_t write = (historyWrite_ + j) % historySize_;
+        feedbackHistory_[write] = wet;
+        feedbackHistory_[write + historySize_] = wet;
     }
 }
 
@@ -0,0 +1,1215 @@
+#include "VerbSuite/AudioFile.h"
+#include "VerbSuite/BlockProfiler.h"
+#include "VerbSuite/CVFollower.h"
+#include "VerbSuite/FFT.h"
+#include "VerbSuite/FastMath.h"
+#include "VerbSuite/IRSynthesisPool.h"
+#include "VerbSuite/Random.h"
+#include "VerbSuite/TapKernel.h"
+#include "VerbSuite/WeirdConvolutionReverb.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct BlockStats {
+    double meanUs = 0.0;
+    double worstUs = 0.0;
+};
+
+void fillTestSignal(std::vector<float>& left, std::vector<float>& right, int sampleRate) {
+    for (std::size_t i = 0; i < left.size(); ++i) {
+        float x = (i % static_cast<std::size_t>(sampleRate / 2) == 0) ? 1.0f : 0.0f;
+        x += 0.25f * std::sin(2.0f * 3.14159265358979323846f * 220.0f * static_cast<float>(i) / static_cast<float>(sampleRate));
+        left[i] = x;
+        right[i] = 0.7f * x;
+    }
+}
+
+BlockStats timeEngine(verbsuite::ConvolutionEngine engine, verbsuite::WeirdMode mode, std::size_t blockSize, double seconds) {
+    constexpr int sampleRate = 48000;
+    verbsuite::WeirdConvolutionReverb reverb(sampleRate, blockSize, mode);
+    reverb.setConvolutionEngine(engine);
+
+    verbsuite::WeirdControls controls;
+    controls.stability = 0.35f;
+    controls.entropy = 0.6f;
+    controls.wildIrBank = true;
+    reverb.setControls(controls);
+
+    const auto totalSamples = static_cast<std::size_t>(seconds * sampleRate);
+    std::vector<float> left(totalSamples);
+    std::vector<float> right(totalSamples);
+    fillTestSignal(left, right, sampleRate);
+
+    BlockStats stats;
+    std::size_t blocks = 0;
+    double totalUs = 0.0;
+    for (std::size_t base = 0; base + blockSize <= totalSamples; base += blockSize) {
+        const auto start = std::chrono::steady_clock::now();
+        reverb.processBlock(left.data() + base, right.data() + base, blockSize);
+        const auto end = std::chrono::steady_clock::now();
+        const double us = std::chrono::duration<double, std::micro>(end - start).count();
+        totalUs += us;
+        stats.worstUs = std::max(stats.worstUs, us);
+        ++blocks;
+    }
+    stats.meanUs = blocks > 0 ? totalUs / static_cast<double>(blocks) : 0.0;
+    return stats;
+}
+
+// Direct-form tap kernel on its own: three bands per sample at the widest tap
+// span the engine uses, with feedback on, as three single-band calls and as one
+// fused pass. Returns ns per sample and checks the results against the scalar
+// kernel bit for bit.
+struct KernelStats {
+    double nsPerSample = 0.0;
+    double fusedNsPerSample = 0.0;
+    bool bitExact = true;
+};
+
+KernelStats timeTapKernel(verbsuite::TapKernel kernel, double seconds) {
+    constexpr std::size_t historySize = 12288;
+    constexpr std::size_t tapSpan = 304;
+    constexpr std::size_t stride = 2;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> input(historySize * 2);
+    std::vector<float> feedback(historySize * 2);
+    std::vector<float> ir(tapSpan);
+    for (std::size_t i = 0; i < historySize; ++i) {
+        input[i] = input[i + historySize] = dist(rng);
+        feedback[i] = feedback[i + historySize] = dist(rng);
+    }
+    for (auto& tap : ir) {
+        tap = dist(rng);
+    }
+    std::vector<float> packed(verbsuite::FusedStridedTaps::kLanes * tapSpan);
+    verbsuite::packStridedIRs({ ir.data(), ir.data(), ir.data() }, { tapSpan, tapSpan, tapSpan }, stride, tapSpan / stride, packed.data());
+
+    const std::size_t zeroIndex[] = { 3, 7, 40 };
+    const auto totalSamples = static_cast<std::size_t>(seconds * 48000.0);
+    KernelStats stats;
+    float sink = 0.0f;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < totalSamples; ++n) {
+        const std::size_t write = n % historySize;
+        for (const auto zero : zeroIndex) {
+            verbsuite::StridedTaps taps;
+            taps.input = input.data() + write + historySize;
+            taps.feedback = feedback.data() + write + historySize - 1;
+            taps.feedbackAmount = 0.21f;
+            taps.ir = ir.data();
+            taps.zeroIndex = zero;
+            taps.stride = stride;
+            taps.count = tapSpan / stride;
+            const float wet = verbsuite::stridedTapSum(taps, kernel);
+            sink += wet;
+            if ((n & 1023) == 0) {
+                const float reference = verbsuite::stridedTapSum(taps, verbsuite::TapKernel::Scalar);
+                stats.bitExact = stats.bitExact && std::memcmp(&wet, &reference, sizeof(float)) == 0;
+            }
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    stats.nsPerSample = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(std::max<std::size_t>(1, totalSamples));
+
+    const auto fusedStart = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < totalSamples; ++n) {
+        const std::size_t write = n % historySize;
+        verbsuite::FusedStridedTaps taps;
+        taps.input = input.data() + write + historySize;
+        taps.feedback = feedback.data() + write + historySize - 1;
+        taps.feedbackAmount = 0.21f;
+        taps.packedIR = packed.data();
+        taps.zeroIndex = { zeroIndex[0], zeroIndex[1], zeroIndex[2] };
+        taps.count = { tapSpan / stride, tapSpan / stride, tapSpan / stride };
+        taps.stride = stride;
+        float wet[verbsuite::FusedStridedTaps::kBands];
+        verbsuite::fusedTapSum(taps, wet, kernel);
+        sink += wet[0] + wet[1] + wet[2];
+        if ((n & 1023) == 0) {
+            float reference[verbsuite::FusedStridedTaps::kBands];
+            verbsuite::fusedTapSum(taps, reference, verbsuite::TapKernel::Scalar);
+            stats.bitExact = stats.bitExact && std::memcmp(wet, reference, sizeof(wet)) == 0;
+            for (std::size_t b = 0; b < verbsuite::FusedStridedTaps::kBands; ++b) {
+                verbsuite::StridedTaps single;
+                single.input = taps.input;
+                single.feedback = taps.feedback;
+                single.feedbackAmount = taps.feedbackAmount;
+                single.ir = ir.data();
+                single.zeroIndex = zeroIndex[b];
+                single.stride = stride;
+                single.count = tapSpan / stride;
+                const float expected = verbsuite::stridedTapSum(single, verbsuite::TapKernel::Scalar);
+                stats.bitExact = stats.bitExact && std::memcmp(&wet[b], &expected, sizeof(float)) == 0;
+            }
+        }
+    }
+    const auto fusedEnd = std::chrono::steady_clock::now();
+    stats.fusedNsPerSample = std::chrono::duration<double, std::nano>(fusedEnd - fusedStart).count() / static_cast<double>(std::max<std::size_t>(1, totalSamples));
+    if (sink == 12345.0f) {
+        std::printf(" ");
+    }
+    return stats;
+}
+
+// Cost of one uniform draw, in ns: the old mt19937 with a distribution built
+// per call, RandomStream one draw at a time, and RandomStream batch fill.
+struct RandomStats {
+    double mt19937Ns = 0.0;
+    double streamNs = 0.0;
+    double fillNs = 0.0;
+};
+
+RandomStats timeRandom(double seconds) {
+    const auto draws = static_cast<std::size_t>(seconds * 48000.0 * 64.0);
+    RandomStats stats;
+    float sink = 0.0f;
+
+    std::mt19937 mt(0xC0FFEEu);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < draws; ++i) {
+        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+        sink += dist(mt);
+    }
+    auto end = std::chrono::steady_clock::now();
+    stats.mt19937Ns = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(draws);
+
+    verbsuite::RandomStream stream(0xC0FFEEu);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < draws; ++i) {
+        sink += stream.uniform();
+    }
+    end = std::chrono::steady_clock::now();
+    stats.streamNs = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(draws);
+
+    std::vector<float> batch(256);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < draws; i += batch.size()) {
+        stream.fill(batch.data(), batch.size());
+        sink += batch.back();
+    }
+    end = std::chrono::steady_clock::now();
+    stats.fillNs = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(draws);
+
+    if (sink == 12345.0f) {
+        std::printf(" ");
+    }
+    return stats;
+}
+
+// Sidechain CV conditioning in ns/sample at block 256: the loop the plugin
+// used to run inline (scratch resized and exp per block, modulo step hold)
+// against CVFollower, and whether the two agree bit for bit.
+struct CVStats {
+    double legacyNs = 0.0;
+    double followerNs = 0.0;
+    bool bitExact = true;
+};
+
+CVStats timeCVFollower(verbsuite::CVShape shape, double seconds) {
+    constexpr int sampleRate = 48000;
+    constexpr std::size_t blockSize = 256;
+    const auto totalSamples = std::max(blockSize, static_cast<std::size_t>(seconds * sampleRate) / blockSize * blockSize);
+    std::vector<float> left(totalSamples);
+    std::vector<float> right(totalSamples);
+    fillTestSignal(left, right, sampleRate);
+
+    const float tau = 0.120f;
+    const int stepPeriod = 48;
+    const bool envelope = shape == verbsuite::CVShape::Envelope;
+    std::vector<float> legacyOut(totalSamples);
+    float state = 0.0f;
+    float held = 0.0f;
+    int counter = 0;
+    float sink = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t base = 0; base < totalSamples; base += blockSize) {
+        std::vector<float> scratch;
+        const float attackAlpha = 1.0f - std::exp(-1.0f / (std::max(0.001f, tau * 0.30f) * sampleRate));
+        const float releaseAlpha = 1.0f - std::exp(-1.0f / (std::max(0.005f, tau * 2.40f) * sampleRate));
+        scratch.resize(blockSize);
+        float peak = 0.0f;
+        for (std::size_t i = 0; i < blockSize; ++i) {
+            const float raw = std::clamp(0.5f * (left[base + i] + right[base + i]), -1.0f, 1.0f);
+            float shaped = raw;
+            if (envelope) {
+                const float target = std::abs(raw);
+                const float alpha = target > state ? attackAlpha : releaseAlpha;
+                state += alpha * (target - state);
+                if ((counter++ % stepPeriod) == 0) {
+                    held = state;
+                }
+                shaped = held;
+            }
+            scratch[i] = shaped;
+            peak = std::max(peak, std::abs(shaped));
+        }
+        std::copy(scratch.begin(), scratch.end(), legacyOut.begin() + static_cast<std::ptrdiff_t>(base));
+        sink += peak;
+    }
+    auto end = std::chrono::steady_clock::now();
+    CVStats stats;
+    stats.legacyNs = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(totalSamples);
+
+    verbsuite::CVFollower follower;
+    follower.prepare(sampleRate, blockSize, 16);
+    verbsuite::CVFollowerSettings settings;
+    settings.shape = shape;
+    settings.attackSeconds = std::max(0.001f, tau * 0.30f);
+    settings.releaseSeconds = std::max(0.005f, tau * 2.40f);
+    settings.holdPeriod = stepPeriod;
+    std::vector<float> followerOut(totalSamples);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t base = 0; base < totalSamples; base += blockSize) {
+        follower.setSettings(settings);
+        const auto cv = follower.process(left.data() + base, right.data() + base, blockSize);
+        std::copy(cv.begin(), cv.end(), followerOut.begin() + static_cast<std::ptrdiff_t>(base));
+        sink += follower.peak();
+    }
+    end = std::chrono::steady_clock::now();
+    stats.followerNs = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(totalSamples);
+    stats.bitExact = followerOut == legacyOut;
+
+    if (sink == 12345.0f) {
+        std::printf(" ");
+    }
+    return stats;
+}
+
+// Accuracy and cost of one fast-math approximation against libm: max absolute
+// error over a dense sweep, the loudest component of the error spectrum for a
+// driven test tone (dB relative to the tone), and ns per call for both.
+struct ApproxStats {
+    double maxError = 0.0;
+    double spurDb = 0.0;
+    double libmNs = 0.0;
+    double fastNs = 0.0;
+};
+
+template <typename Exact, typename Fast>
+ApproxStats measureApprox(Exact exact, Fast fast, float sweepMin, float sweepMax, float drive, double seconds) {
+    ApproxStats stats;
+    for (float x = sweepMin; x < sweepMax; x += 1.0e-4f) {
+        stats.maxError = std::max(stats.maxError, std::fabs(static_cast<double>(fast(x)) - static_cast<double>(exact(x))));
+    }
+
+    constexpr std::size_t fftSize = 8192;
+    verbsuite::RealFFT fft(fftSize);
+    std::vector<float> tone(fftSize);
+    std::vector<float> error(fftSize);
+    std::vector<float> re(fft.numBins());
+    std::vector<float> im(fft.numBins());
+    for (std::size_t i = 0; i < fftSize; ++i) {
+        // Hann-windowed test signal whose argument swings +-drive 75 times per frame.
+        const float phase = drive * std::sin(2.0f * 3.14159265358979323846f * 75.0f * static_cast<float>(i) / static_cast<float>(fftSize));
+        const float window = 0.5f - 0.5f * std::cos(2.0f * 3.14159265358979323846f * static_cast<float>(i) / static_cast<float>(fftSize));
+        tone[i] = exact(phase) * window;
+        error[i] = (fast(phase) - exact(phase)) * window;
+    }
+    const auto peak = [&](const std::vector<float>& signal) {
+        fft.forward(signal.data(), re.data(), im.data());
+        double best = 0.0;
+        for (std::size_t b = 0; b < re.size(); ++b) {
+            best = std::max(best, std::hypot(static_cast<double>(re[b]), static_cast<double>(im[b])));
+        }
+        return best;
+    };
+    stats.spurDb = 20.0 * std::log10(std::max(1.0e-30, peak(error)) / std::max(1.0e-30, peak(tone)));
+
+    std::vector<float> input(4096);
+    std::vector<float> output(input.size());
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        input[i] = sweepMin + (sweepMax - sweepMin) * static_cast<float>(i) / static_cast<float>(input.size());
+    }
+    const auto passes = static_cast<std::size_t>(std::max(1.0, seconds * 48000.0 * 8.0 / static_cast<double>(input.size())));
+    const auto time = [&](auto fn) {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t p = 0; p < passes; ++p) {
+            for (std::size_t i = 0; i < input.size(); ++i) {
+                output[i] = fn(input[i]);
+            }
+            input[p % input.size()] += output[(p * 7) % output.size()] * 1.0e-9f;
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(passes * input.size());
+    };
+    stats.libmNs = time(exact);
+    stats.fastNs = time(fast);
+    return stats;
+}
+
+// Per-stage cost of the block core for one mode, in ns per sample.
+verbsuite::StageTimings timeStages(verbsuite::WeirdMode mode, std::size_t blockSize, double seconds) {
+    constexpr int sampleRate = 48000;
+    verbsuite::WeirdConvolutionReverb reverb(sampleRate, blockSize, mode);
+    verbsuite::WeirdControls controls;
+    controls.stability = 0.35f;
+    controls.entropy = 0.6f;
+    controls.wildIrBank = true;
+    reverb.setControls(controls);
+    reverb.setStageTimingEnabled(true);
+
+    const auto totalSamples = static_cast<std::size_t>(seconds * sampleRate);
+    std::vector<float> left(totalSamples);
+    std::vector<float> right(totalSamples);
+    fillTestSignal(left, right, sampleRate);
+    for (std::size_t base = 0; base + blockSize <= totalSamples; base += blockSize) {
+        reverb.processBlock(left.data() + base, right.data() + base, blockSize);
+    }
+    return reverb.stageTimings();
+}
+
+// Throughput of streaming `audioSeconds` of 48 kHz stereo to disk in
+// renderer-sized chunks, as x realtime: the old per-frame 16-bit writer, then
+// AudioFileWriter in each format, then reading the float file back.
+struct FileStats {
+    double legacy = 0.0;
+    double writer[4] = {};
+    double streamRead = 0.0;
+    double mappedRead = 0.0;
+};
+
+FileStats timeAudioFiles(double audioSeconds) {
+    constexpr int sampleRate = 48000;
+    constexpr std::size_t chunk = 8192;
+    const auto totalFrames = static_cast<std::size_t>(audioSeconds * sampleRate);
+    const auto path = (std::filesystem::temp_directory_path() / "verb_bench_audio.wav").string();
+    std::vector<float> left(chunk);
+    std::vector<float> right(chunk);
+    fillTestSignal(left, right, sampleRate);
+    float* const channels[] = { left.data(), right.data() };
+    const auto realtime = [audioSeconds](auto start) {
+        return audioSeconds / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    FileStats stats;
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(std::string(44, '\0').data(), 44); // Header contents don't affect the timing.
+        for (std::size_t done = 0; done < totalFrames; done += chunk) {
+            for (std::size_t i = 0; i < std::min(chunk, totalFrames - done); ++i) {
+                const auto l = static_cast<std::int16_t>(std::clamp(left[i], -1.0f, 1.0f) * 32767.0f);
+                const auto r = static_cast<std::int16_t>(std::clamp(right[i], -1.0f, 1.0f) * 32767.0f);
+                out.write(reinterpret_cast<const char*>(&l), 2);
+                out.write(reinterpret_cast<const char*>(&r), 2);
+            }
+        }
+    }
+    stats.legacy = realtime(start);
+
+    const verbsuite::SampleFormat formats[] = { verbsuite::SampleFormat::Int16, verbsuite::SampleFormat::Int24, verbsuite::SampleFormat::Int32, verbsuite::SampleFormat::Float32 };
+    for (std::size_t f = 0; f < std::size(formats); ++f) {
+        start = std::chrono::steady_clock::now();
+        verbsuite::AudioFileWriter writer(path, sampleRate, 2, formats[f]);
+        for (std::size_t done = 0; done < totalFrames; done += chunk) {
+            writer.write(channels, std::min(chunk, totalFrames - done));
+        }
+        writer.close();
+        stats.writer[f] = realtime(start);
+    }
+
+    for (const auto access : { verbsuite::AudioFileReader::Access::Stream, verbsuite::AudioFileReader::Access::MemoryMap }) {
+        start = std::chrono::steady_clock::now();
+        verbsuite::AudioFileReader reader(path, access);
+        while (reader.read(channels, chunk) > 0) {
+        }
+        (access == verbsuite::AudioFileReader::Access::Stream ? stats.streamRead : stats.mappedRead) = realtime(start);
+    }
+    std::filesystem::remove(path);
+    return stats;
+}
+
+// One cell of the JSON matrix: processBlock() timed block by block.
+struct MatrixCase {
+    verbsuite::WeirdMode mode = verbsuite::WeirdMode::LivingSignal;
+    bool wildBank = false;
+    bool freeze = false;
+    bool cv = false;
+    std::size_t blockSize = 256;
+    int sampleRate = 48000;
+};
+
+struct MatrixResult {
+    std::size_t blocks = 0;
+    double meanUs = 0.0;
+    double p99Us = 0.0;
+    double worstUs = 0.0;
+};
+
+MatrixResult timeMatrixCase(const MatrixCase& c, verbsuite::ConvolutionEngine engine, verbsuite::IRSynthesisMode synthesis, double seconds) {
+    verbsuite::WeirdConvolutionReverb reverb(c.sampleRate, c.blockSize, c.mode);
+    reverb.setConvolutionEngine(engine);
+    reverb.setIRSynthesisMode(synthesis);
+    verbsuite::WeirdControls controls;
+    controls.stability = 0.35f;
+    controls.entropy = 0.6f;
+    controls.wildIrBank = c.wildBank;
+    controls.freeze = c.freeze;
+    reverb.setControls(controls);
+
+    const auto totalSamples = std::max(c.blockSize, static_cast<std::size_t>(seconds * c.sampleRate));
+    std::vector<float> left(totalSamples);
+    std::vector<float> right(totalSamples);
+    fillTestSignal(left, right, c.sampleRate);
+    // A stepped 3 Hz ramp, so the CV path sees both slow motion and jumps.
+    std::vector<float> cv(c.cv ? totalSamples : 0);
+    for (std::size_t i = 0; i < cv.size(); ++i) {
+        cv[i] = std::fmod(3.0f * static_cast<float>(i) / static_cast<float>(c.sampleRate), 1.0f);
+    }
+
+    std::vector<double> times;
+    times.reserve(totalSamples / c.blockSize);
+    for (std::size_t base = 0; base + c.blockSize <= totalSamples; base += c.blockSize) {
+        const auto start = std::chrono::steady_clock::now();
+        reverb.processBlock(left.data() + base, right.data() + base, c.blockSize, c.cv ? cv.data() + base : nullptr, c.cv ? 0.8f : 0.0f);
+        const auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+
+    MatrixResult result;
+    result.blocks = times.size();
+    for (const double t : times) {
+        result.meanUs += t;
+        result.worstUs = std::max(result.worstUs, t);
+    }
+    result.meanUs /= static_cast<double>(times.size());
+    const auto p99 = times.begin() + static_cast<std::ptrdiff_t>(std::min(times.size() - 1, times.size() * 99 / 100));
+    std::nth_element(times.begin(), p99, times.end());
+    result.p99Us = *p99;
+    return result;
+}
+
+template <typename T>
+std::vector<T> parseList(const std::string& text) {
+    std::vector<T> values;
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        values.push_back(static_cast<T>(std::stod(item)));
+    }
+    return values;
+}
+
+const char* engineKey(verbsuite::ConvolutionEngine engine) {
+    switch (engine) {
+    case verbsuite::ConvolutionEngine::Direct: return "direct";
+    case verbsuite::ConvolutionEngine::Partitioned: return "upols";
+    case verbsuite::ConvolutionEngine::NonUniform: return "nupols";
+    }
+    return "direct";
+}
+
+const char* synthesisKey(verbsuite::IRSynthesisMode mode) {
+    switch (mode) {
+    case verbsuite::IRSynthesisMode::Inline: return "inline";
+    case verbsuite::IRSynthesisMode::Background: return "background";
+    case verbsuite::IRSynthesisMode::Amortized: return "amortized";
+    case verbsuite::IRSynthesisMode::SharedPool: return "pool";
+    }
+    return "inline";
+}
+
+// `verb_bench --json <file|-> [--seconds S] [--engine direct|upols|nupols]
+// [--synthesis inline|background|amortized|pool] [--modes 0,1,..] [--blocks 16,..]
+// [--rates 44100,..]`: every combination of
+// mode, IR bank, freeze and CV at each block size and rate, as JSON. Each
+// result carries the deadline (the block's duration) and the load and margin
+// against it; a worst-case load at or above 1 is a dropout.
+int runMatrix(int argc, char** argv) {
+    std::string outPath = "-";
+    double seconds = 0.5;
+    auto engine = verbsuite::ConvolutionEngine::Direct;
+    auto synthesis = verbsuite::IRSynthesisMode::Inline;
+    std::vector<int> modes;
+    for (int m = 0; m < verbsuite::WeirdConvolutionReverb::modeCount(); ++m) {
+        modes.push_back(m);
+    }
+    std::vector<std::size_t> blockSizes = { 16, 32, 64, 128, 256, 512, 1024, 2048 };
+    std::vector<int> rates = { 44100, 48000, 88200, 96000, 176400, 192000 };
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "%s needs a value\n", flag.c_str());
+            return 2;
+        }
+        const std::string value = argv[++i];
+        if (flag == "--json") {
+            outPath = value;
+        } else if (flag == "--seconds") {
+            seconds = std::max(0.05, std::stod(value));
+        } else if (flag == "--engine") {
+            if (value == "direct") engine = verbsuite::ConvolutionEngine::Direct;
+            else if (value == "upols") engine = verbsuite::ConvolutionEngine::Partitioned;
+            else if (value == "nupols") engine = verbsuite::ConvolutionEngine::NonUniform;
+            else {
+                std::fprintf(stderr, "unknown engine '%s'\n", value.c_str());
+                return 2;
+            }
+        } else if (flag == "--synthesis") {
+            if (value == "inline") synthesis = verbsuite::IRSynthesisMode::Inline;
+            else if (value == "background") synthesis = verbsuite::IRSynthesisMode::Background;
+            else if (value == "amortized") synthesis = verbsuite::IRSynthesisMode::Amortized;
+            else if (value == "pool") synthesis = verbsuite::IRSynthesisMode::SharedPool;
+            else {
+                std::fprintf(stderr, "unknown synthesis mode '%s'\n", value.c_str());
+                return 2;
+            }
+        } else if (flag == "--modes") {
+            modes = parseList<int>(value);
+        } else if (flag == "--blocks") {
+            blockSizes = parseList<std::size_t>(value);
+        } else if (flag == "--rates") {
+            rates = parseList<int>(value);
+        } else {
+            std::fprintf(stderr, "unknown flag '%s'\n", flag.c_str());
+            return 2;
+        }
+    }
+
+    std::FILE* out = outPath == "-" ? stdout : std::fopen(outPath.c_str(), "w");
+    if (out == nullptr) {
+        std::fprintf(stderr, "Failed to open %s\n", outPath.c_str());
+        return 1;
+    }
+#if defined(NDEBUG)
+    constexpr bool optimized = true;
+#else
+    constexpr bool optimized = false;
+#endif
+    std::fprintf(out, "{\n  \"schema\": 1,\n  \"fast_math\": %s,\n  \"optimized\": %s,\n  \"engine\": \"%s\",\n  \"synthesis\": \"%s\",\n  \"seconds\": %g,\n  \"results\": [",
+        VERBSUITE_FAST_MATH ? "true" : "false",
+        optimized ? "true" : "false",
+        engineKey(engine),
+        synthesisKey(synthesis),
+        seconds);
+
+    const std::size_t total = modes.size() * 8 * blockSizes.size() * rates.size();
+    std::size_t done = 0;
+    double worstLoad = 0.0;
+    for (const int rate : rates) {
+        for (const std::size_t blockSize : blockSizes) {
+            for (const int m : modes) {
+                for (int variant = 0; variant < 8; ++variant) {
+                    MatrixCase c;
+                    c.mode = verbsuite::WeirdConvolutionReverb::modeFromIndex(m);
+                    c.wildBank = (variant & 1) != 0;
+                    c.freeze = (variant & 2) != 0;
+                    c.cv = (variant & 4) != 0;
+                    c.blockSize = blockSize;
+                    c.sampleRate = rate;
+                    const auto r = timeMatrixCase(c, engine, synthesis, seconds);
+                    const double deadlineUs = 1.0e6 * static_cast<double>(blockSize) / rate;
+                    worstLoad = std::max(worstLoad, r.worstUs / deadlineUs);
+                    std::fprintf(out,
+                        "%s\n    {\"mode\": \"%s\", \"mode_index\": %d, \"bank\": \"%s\", \"freeze\": %s, \"cv\": %s, \"block\": %zu, \"rate\": %d, "
+                        "\"blocks\": %zu, \"mean_us\": %.3f, \"p99_us\": %.3f, \"worst_us\": %.3f, \"deadline_us\": %.3f, "
+                        "\"mean_load\": %.5f, \"p99_load\": %.5f, \"worst_load\": %.5f, \"margin_us\": %.3f}",
+                        done == 0 ? "" : ",",
+                        verbsuite::WeirdConvolutionReverb::modeName(c.mode).c_str(),
+                        m,
+                        c.wildBank ? "wild" : "core",
+                        c.freeze ? "true" : "false",
+                        c.cv ? "true" : "false",
+                        blockSize,
+                        rate,
+                        r.blocks,
+                        r.meanUs,
+                        r.p99Us,
+                        r.worstUs,
+                        deadlineUs,
+                        r.meanUs / deadlineUs,
+                        r.p99Us / deadlineUs,
+                        r.worstUs / deadlineUs,
+                        deadlineUs - r.worstUs);
+                    ++done;
+                }
+                std::fprintf(stderr, "\r%zu/%zu cases", done, total);
+            }
+        }
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    std::fprintf(stderr, "\nworst-case load %.3f of the block deadline\n", worstLoad);
+    return 0;
+}
+
+// `verb_bench --profile [seconds] [block] [rate]`: per-block cycle counts from
+// the engine's BlockProfiler for every mode at four stabilities, split into
+// plain blocks and blocks that hit an IR update, with the stale-band and
+// reversal events those updates produced and the blocks that missed their
+// deadline. Needs a VERBSUITE_BLOCK_PROFILER build.
+int runProfile(int argc, char** argv) {
+    if (!verbsuite::WeirdConvolutionReverb::blockProfilerCompiledIn()) {
+        std::fprintf(stderr, "verb_bench --profile needs a build with -DVERBSUITE_BLOCK_PROFILER=ON\n");
+        return 1;
+    }
+    const double seconds = argc > 2 ? std::max(0.5, std::stod(argv[2])) : 4.0;
+    const std::size_t blockSize = argc > 3 ? std::max<std::size_t>(1, std::stoul(argv[3])) : 256;
+    const int sampleRate = argc > 4 ? std::max(8000, std::stoi(argv[4])) : 48000;
+
+    const double hz = verbsuite::cycleCounterHz();
+    const double usPerCycle = 1.0e6 / hz;
+    const double deadlineUs = 1.0e6 * static_cast<double>(blockSize) / sampleRate;
+    const auto deadlineCycles = static_cast<std::uint64_t>(deadlineUs / usPerCycle);
+    std::printf("block %zu at %d Hz: deadline %.1f us (%.3g counter ticks/us)\n\n", blockSize, sampleRate, deadlineUs, 1.0 / usPerCycle);
+    std::printf("%-18s %5s %8s %9s %9s %9s %8s %9s %9s %9s %6s %6s %6s\n",
+        "mode", "stab", "plain", "p50 us", "p99 us", "max us", "update", "p50 us", "p99 us", "max us", "stale", "rev", "miss");
+
+    const auto totalSamples = static_cast<std::size_t>(seconds * sampleRate);
+    std::vector<float> left(totalSamples);
+    std::vector<float> right(totalSamples);
+    for (int m = 0; m < verbsuite::WeirdConvolutionReverb::modeCount(); ++m) {
+        for (const float stability : { 0.05f, 0.35f, 0.65f, 0.95f }) {
+            const auto mode = verbsuite::WeirdConvolutionReverb::modeFromIndex(m);
+            verbsuite::WeirdConvolutionReverb reverb(sampleRate, blockSize, mode);
+            verbsuite::WeirdControls controls;
+            controls.stability = stability;
+            controls.entropy = 0.6f;
+            controls.wildIrBank = true;
+            reverb.setControls(controls);
+            verbsuite::BlockProfiler profiler(totalSamples / blockSize + 1);
+            reverb.setBlockProfiler(&profiler);
+
+            fillTestSignal(left, right, sampleRate);
+            for (std::size_t base = 0; base + blockSize <= totalSamples; base += blockSize) {
+                reverb.processBlock(left.data() + base, right.data() + base, blockSize);
+            }
+
+            verbsuite::BlockHistogram plain;
+            verbsuite::BlockHistogram update;
+            std::size_t stale = 0;
+            std::size_t reversed = 0;
+            profiler.drain([&](const verbsuite::BlockRecord& record) {
+                const bool updated = verbsuite::hasBlockEvent(record.events, verbsuite::BlockEvent::IRUpdate);
+                (updated ? update : plain).add(record.cycles);
+                stale += verbsuite::hasBlockEvent(record.events, verbsuite::BlockEvent::StaleBand) ? 1 : 0;
+                reversed += verbsuite::hasBlockEvent(record.events, verbsuite::BlockEvent::Reversal) ? 1 : 0;
+            });
+            const auto us = [usPerCycle](std::uint64_t cycles) { return static_cast<double>(cycles) * usPerCycle; };
+            std::printf("%-18s %5.2f %8llu %9.1f %9.1f %9.1f %8llu %9.1f %9.1f %9.1f %6zu %6zu %6llu\n",
+                verbsuite::WeirdConvolutionReverb::modeName(mode).c_str(),
+                stability,
+                static_cast<unsigned long long>(plain.count()),
+                us(plain.quantile(0.5)),
+                us(plain.quantile(0.99)),
+                us(plain.max()),
+                static_cast<unsigned long long>(update.count()),
+                us(update.quantile(0.5)),
+                us(update.quantile(0.99)),
+                us(update.max()),
+                stale,
+                reversed,
+                static_cast<unsigned long long>(plain.countAbove(deadlineCycles) + update.countAbove(deadlineCycles)));
+        }
+    }
+    return 0;
+}
+
+struct PoolRun {
+    double cpuLoad = 0.0;
+    double meanUs = 0.0;
+    double worstUs = 0.0;
+    std::size_t callbacks = 0;
+    std::size_t overruns = 0;
+};
+
+// `engines` engines cycling through the modes, split across `audioThreads`
+// host-like callback threads that each wake once per block period and process
+// their share. cpuLoad is process CPU time over wall time, in cores.
+PoolRun runPoolCase(verbsuite::IRSynthesisMode synthesis, std::size_t engines, std::size_t audioThreads, double seconds, std::size_t blockSize, int sampleRate) {
+    std::vector<std::unique_ptr<verbsuite::WeirdConvolutionReverb>> reverbs;
+    for (std::size_t e = 0; e < engines; ++e) {
+        const auto mode = verbsuite::WeirdConvolutionReverb::modeFromIndex(static_cast<int>(e) % verbsuite::WeirdConvolutionReverb::modeCount());
+        auto reverb = std::make_unique<verbsuite::WeirdConvolutionReverb>(sampleRate, blockSize, mode);
+        reverb->setRandomSeed(0xC0FFEEu, static_cast<std::uint32_t>(e));
+        reverb->setIRSynthesisMode(synthesis);
+        verbsuite::WeirdControls controls;
+        controls.stability = 0.35f;
+        controls.entropy = 0.6f;
+        controls.wildIrBank = e % 2 == 1;
+        reverb->setControls(controls);
+        reverbs.push_back(std::move(reverb));
+    }
+    const auto totalSamples = static_cast<std::size_t>(seconds * sampleRate);
+    std::vector<float> sourceLeft(totalSamples);
+    std::vector<float> sourceRight(totalSamples);
+    fillTestSignal(sourceLeft, sourceRight, sampleRate);
+
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(static_cast<double>(blockSize) / sampleRate));
+    std::vector<std::vector<double>> times(audioThreads);
+    std::vector<std::thread> threads;
+    const auto wallStart = std::chrono::steady_clock::now();
+    const std::clock_t cpuStart = std::clock();
+    for (std::size_t t = 0; t < audioThreads; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<float> left(blockSize);
+            std::vector<float> right(blockSize);
+            auto next = wallStart;
+            for (std::size_t base = 0; base + blockSize <= totalSamples; base += blockSize) {
+                std::this_thread::sleep_until(next);
+                next += period;
+                const auto start = std::chrono::steady_clock::now();
+                for (std::size_t e = t; e < engines; e += audioThreads) {
+                    std::copy_n(sourceLeft.data() + base, blockSize, left.data());
+                    std::copy_n(sourceRight.data() + base, blockSize, right.data());
+                    reverbs[e]->processBlock(left.data(), right.data(), blockSize);
+                }
+                const auto end = std::chrono::steady_clock::now();
+                times[t].push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    PoolRun run;
+    run.cpuLoad = cpuSeconds / wallSeconds;
+    const double deadlineUs = 1.0e6 * static_cast<double>(blockSize) / sampleRate;
+    for (const auto& perThread : times) {
+        for (const double t : perThread) {
+            run.meanUs += t;
+            run.worstUs = std::max(run.worstUs, t);
+            run.overruns += t > deadlineUs ? 1 : 0;
+            ++run.callbacks;
+        }
+    }
+    run.meanUs /= static_cast<double>(std::max<std::size_t>(1, run.callbacks));
+    return run;
+}
+
+// `verb_bench --pool [engines] [seconds] [block] [audio threads]`: a
+// multi-instance stress test. The same engines run in realtime-paced callbacks
+// with inline IR synthesis, a dedicated worker thread each, and the shared
+// pool, reporting CPU load, per-callback time, overruns, and the pool's late
+// and stolen jobs.
+int runPool(int argc, char** argv) {
+    const std::size_t engines = argc > 2 ? std::max<std::size_t>(1, std::stoul(argv[2])) : 64;
+    const double seconds = argc > 3 ? std::max(0.5, std::stod(argv[3])) : 4.0;
+    const std::size_t blockSize = argc > 4 ? std::max<std::size_t>(16, std::stoul(argv[4])) : 256;
+    const std::size_t audioThreads = argc > 5 ? std::max<std::size_t>(1, std::stoul(argv[5])) : 4;
+    const int sampleRate = 48000;
+
+    auto& pool = verbsuite::IRSynthesisPool::shared();
+    std::printf("%zu engines, block %zu at %d Hz on %zu audio threads: deadline %.1f us; pool has %zu threads\n\n",
+        engines, blockSize, sampleRate, audioThreads, 1.0e6 * static_cast<double>(blockSize) / sampleRate, pool.threadCount());
+    std::printf("%-12s %9s %10s %10s %9s %8s %8s %8s\n", "synthesis", "cpu load", "mean us", "worst us", "overruns", "jobs", "late", "stolen");
+    for (const auto synthesis : { verbsuite::IRSynthesisMode::Inline, verbsuite::IRSynthesisMode::Background, verbsuite::IRSynthesisMode::SharedPool }) {
+        const auto before = pool.stats();
+        const auto run = runPoolCase(synthesis, engines, audioThreads, seconds, blockSize, sampleRate);
+        const auto after = pool.stats();
+        std::printf("%-12s %9.2f %10.1f %10.1f %9zu",
+            synthesisKey(synthesis), run.cpuLoad, run.meanUs, run.worstUs, run.overruns);
+        if (synthesis == verbsuite::IRSynthesisMode::SharedPool) {
+            std::printf(" %8llu %8llu %8llu\n",
+                static_cast<unsigned long long>(after.jobs - before.jobs),
+                static_cast<unsigned long long>(after.late - before.late),
+                static_cast<unsigned long long>(after.stolen - before.stolen));
+        } else {
+            std::printf(" %8s %8s %8s\n", "-", "-", "-");
+        }
+    }
+    return 0;
+}
+
+// Resident set size of this process in bytes, or 0 where unsupported.
+std::size_t residentBytes() {
+#if defined(__APPLE__)
+    mach_task_basic_info info {};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+        return static_cast<std::size_t>(info.resident_size);
+    }
+    return 0;
+#elif defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    std::size_t pages = 0;
+    std::size_t resident = 0;
+    statm >> pages >> resident;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+// `verb_bench --memory [instances] [hq] [block] [rate]`: resident memory per
+// plugin instance. Each instance is the realtime engine as the plugin prepares
+// it (background synthesis, non-uniform backend ready) plus, for `hq` 2 or 24,
+// eagerly built 2x (and 4x) engines; the lazy plugin only adds one while HQ is
+// on. Run one layout per process, since freed heap is not returned.
+int runMemory(int argc, char** argv) {
+    const std::size_t instances = argc > 2 ? std::max<std::size_t>(1, std::stoul(argv[2])) : 100;
+    const std::string hq = argc > 3 ? argv[3] : "0";
+    const std::size_t blockSize = argc > 4 ? std::max<std::size_t>(16, std::stoul(argv[4])) : 512;
+    const double sampleRate = argc > 5 ? std::max(8000.0, std::stod(argv[5])) : 48000.0;
+    std::vector<std::size_t> hqFactors;
+    if (hq == "2" || hq == "24") {
+        hqFactors.push_back(2);
+    }
+    if (hq == "24") {
+        hqFactors.push_back(4);
+    }
+
+    // Builds the shared banks first, so they are not charged to the instances.
+    {
+        const verbsuite::WeirdConvolutionReverb warm(sampleRate, blockSize, verbsuite::WeirdMode::LivingSignal);
+    }
+    for (const auto factor : hqFactors) {
+        const verbsuite::WeirdConvolutionReverb warm(sampleRate * static_cast<double>(factor), blockSize * factor, verbsuite::WeirdMode::LivingSignal);
+    }
+
+    const std::size_t before = residentBytes();
+    std::vector<std::unique_ptr<verbsuite::WeirdConvolutionReverb>> engines;
+    for (std::size_t i = 0; i < instances; ++i) {
+        auto engine = std::make_unique<verbsuite::WeirdConvolutionReverb>(sampleRate, blockSize, verbsuite::WeirdMode::LivingSignal);
+        engine->setIRSynthesisMode(verbsuite::IRSynthesisMode::Background);
+        engine->prepareConvolutionEngine(verbsuite::ConvolutionEngine::NonUniform);
+        engines.push_back(std::move(engine));
+        for (const auto factor : hqFactors) {
+            auto engineHQ = std::make_unique<verbsuite::WeirdConvolutionReverb>(sampleRate * static_cast<double>(factor), blockSize * factor, verbsuite::WeirdMode::LivingSignal);
+            engineHQ->setIRSynthesisMode(verbsuite::IRSynthesisMode::Background);
+            engines.push_back(std::move(engineHQ));
+        }
+    }
+    const std::size_t after = residentBytes();
+    const double totalMB = static_cast<double>(after > before ? after - before : 0) / (1024.0 * 1024.0);
+    std::printf("%zu instances (hq %s), block %zu at %g Hz: %.1f MB resident, %.2f MB per instance\n",
+        instances, hq.c_str(), blockSize, sampleRate, totalMB, totalMB / static_cast<double>(instances));
+    return 0;
+}
+
+// Cost of one mode at a control interval, in ns per sample: the per-sample
+// kernel (every stage but IR synthesis, which control rate does not touch),
+// and within it the input and quantize stages that use the control-rate
+// values. The stability CV is a slow sine, fed at control rate when the
+// interval is above 1.
+struct ControlRun {
+    double kernelNs = 0.0;
+    double controlStagesNs = 0.0;
+};
+
+ControlRun timeControlInterval(verbsuite::WeirdMode mode, std::size_t interval, std::size_t blockSize, double seconds) {
+    constexpr int sampleRate = 48000;
+    verbsuite::WeirdConvolutionReverb reverb(sampleRate, blockSize, mode);
+    verbsuite::WeirdControls controls;
+    controls.stability = 0.35f;
+    controls.entropy = 0.6f;
+    controls.wildIrBank = true;
+    reverb.setControls(controls);
+    reverb.setControlInterval(interval);
+    reverb.setStageTimingEnabled(true);
+
+    const auto totalSamples = static_cast<std::size_t>(seconds * sampleRate);
+    std::vector<float> left(totalSamples);
+    std::vector<float> right(totalSamples);
+    std::vector<float> cv(totalSamples);
+    fillTestSignal(left, right, sampleRate);
+    for (std::size_t i = 0; i < totalSamples; ++i) {
+        cv[i] = std::sin(2.0f * 3.14159265358979323846f * 0.7f * static_cast<float>(i) / static_cast<float>(sampleRate));
+    }
+    std::vector<float> controlCv((blockSize + interval - 1) / interval);
+    for (std::size_t base = 0; base + blockSize <= totalSamples; base += blockSize) {
+        if (interval > 1) {
+            for (std::size_t k = 0; k < controlCv.size(); ++k) {
+                controlCv[k] = cv[base + k * interval];
+            }
+            reverb.processBlockControlRate(left.data() + base, right.data() + base, blockSize, controlCv.data(), 0.5f);
+        } else {
+            reverb.processBlock(left.data() + base, right.data() + base, blockSize, cv.data() + base, 0.5f);
+        }
+    }
+
+    const auto& t = reverb.stageTimings();
+    const double scale = 1.0e9 / static_cast<double>(std::max<std::uint64_t>(1, t.samples));
+    ControlRun run;
+    run.kernelNs = (t.input + t.bandSplit + t.convolution + t.texture + t.quantize + t.output) * scale;
+    run.controlStagesNs = (t.input + t.quantize) * scale;
+    return run;
+}
+
+// `verb_bench --control [seconds] [block]`: per-mode cost at control intervals
+// of 1 (per-sample, the default), 16 and 32 samples, with the kernel time
+// saved relative to 1.
+int runControl(int argc, char** argv) {
+    const double seconds = argc > 2 ? std::max(0.5, std::stod(argv[2])) : 4.0;
+    const std::size_t blockSize = argc > 3 ? std::max<std::size_t>(16, std::stoul(argv[3])) : 256;
+    constexpr std::size_t intervals[] = { 1, 16, 32 };
+
+    std::printf("block %zu at 48000 Hz, stability CV on; kernel ns/sample (input+quantize)\n\n", blockSize);
+    std::printf("%-18s %16s %16s %16s %9s %9s\n", "mode", "N=1", "N=16", "N=32", "save 16", "save 32");
+    for (int m = 0; m < verbsuite::WeirdConvolutionReverb::modeCount(); ++m) {
+        const auto mode = verbsuite::WeirdConvolutionReverb::modeFromIndex(m);
+        ControlRun runs[3];
+        for (std::size_t i = 0; i < 3; ++i) {
+            runs[i] = timeControlInterval(mode, intervals[i], blockSize, seconds);
+        }
+        const auto saved = [&](const ControlRun& run) {
+            return 100.0 * (1.0 - run.kernelNs / std::max(1.0e-9, runs[0].kernelNs));
+        };
+        std::printf("%-18s %7.1f (%6.1f) %7.1f (%6.1f) %7.1f (%6.1f) %8.1f%% %8.1f%%\n",
+            verbsuite::WeirdConvolutionReverb::modeName(mode).c_str(),
+            runs[0].kernelNs, runs[0].controlStagesNs,
+            runs[1].kernelNs, runs[1].controlStagesNs,
+            runs[2].kernelNs, runs[2].controlStagesNs,
+            saved(runs[1]), saved(runs[2]));
+    }
+    return 0;
+}
+
+// Kernel (every stage but IR synthesis) and IR synthesis time of `engines`
+// engines, in ns per frame. Each engine runs `channels` channels through the
+// multichannel form, or two through the stereo form.
+struct ChannelRun {
+    double kernelNs = 0.0;
+    double irUpdateNs = 0.0;
+};
+
+ChannelRun timeChannels(verbsuite::WeirdMode mode, std::size_t engines, std::size_t channels, bool multichannel, std::size_t blockSize, double seconds) {
+    constexpr int sampleRate = 48000;
+    const auto totalSamples = static_cast<std::size_t>(seconds * sampleRate);
+    std::vector<float> left(totalSamples);
+    std::vector<float> right(totalSamples);
+    fillTestSignal(left, right, sampleRate);
+
+    ChannelRun run;
+    for (std::size_t e = 0; e < engines; ++e) {
+        verbsuite::WeirdConvolutionReverb reverb(sampleRate, blockSize, mode);
+        verbsuite::WeirdControls controls;
+        controls.stability = 0.35f;
+        controls.entropy = 0.6f;
+        controls.wildIrBank = true;
+        reverb.setControls(controls);
+        reverb.setStageTimingEnabled(true);
+        if (multichannel) {
+            reverb.prepareChannels(channels);
+        }
+
+        // Every channel its own offset into the test signal, so no two match.
+        std::vector<std::vector<float>> audio(channels, std::vector<float>(totalSamples));
+        for (std::size_t c = 0; c < channels; ++c) {
+            const auto& source = c % 2 == 0 ? left : right;
+            const std::size_t delay = 37 * (e * channels + c);
+            for (std::size_t i = delay; i < totalSamples; ++i) {
+                audio[c][i] = source[i - delay];
+            }
+        }
+        std::vector<float*> pointers(channels);
+        for (std::size_t base = 0; base + blockSize <= totalSamples; base += blockSize) {
+            for (std::size_t c = 0; c < channels; ++c) {
+                pointers[c] = audio[c].data() + base;
+            }
+            if (multichannel) {
+                reverb.processBlock(pointers.data(), channels, blockSize);
+            } else {
+                reverb.processBlock(pointers[0], pointers[channels - 1], blockSize);
+            }
+        }
+
+        const auto& t = reverb.stageTimings();
+        const double scale = 1.0e9 / static_cast<double>(std::max<std::uint64_t>(1, t.samples));
+        run.kernelNs += (t.input + t.bandSplit + t.convolution + t.texture + t.quantize + t.output) * scale;
+        run.irUpdateNs += t.irUpdate * scale;
+    }
+    return run;
+}
+
+// `verb_bench --channels [seconds] [block] [mode]`: one multichannel engine
+// against a stereo engine per channel pair (as when a surround stem is split
+// into pairs) for 2 to 16 channels, then the channel tap kernel alone.
+int runChannels(int argc, char** argv) {
+    const double seconds = argc > 2 ? std::max(0.5, std::stod(argv[2])) : 4.0;
+    const std::size_t blockSize = argc > 3 ? std::max<std::size_t>(16, std::stoul(argv[3])) : 256;
+    const auto mode = verbsuite::WeirdConvolutionReverb::modeFromIndex(argc > 4 ? std::stoi(argv[4]) : 0);
+    constexpr std::size_t channelCounts[] = { 2, 6, 8, 12, 16 };
+
+    std::printf("%s, block %zu at 48000 Hz; ns/frame, kernel + IR synthesis\n\n",
+        verbsuite::WeirdConvolutionReverb::modeName(mode).c_str(), blockSize);
+    std::printf("%-9s %22s %22s %12s\n", "channels", "stereo pairs", "multichannel", "vs 2 ch");
+    double stereoKernel = 0.0;
+    for (const std::size_t channels : channelCounts) {
+        const ChannelRun pairs = timeChannels(mode, channels / 2, 2, false, blockSize, seconds);
+        const ChannelRun multi = timeChannels(mode, 1, channels, true, blockSize, seconds);
+        if (channels == 2) {
+            stereoKernel = multi.kernelNs;
+        }
+        std::printf("%-9zu %10.1f + %9.1f %10.1f + %9.1f %11.2fx\n",
+            channels,
+            pairs.kernelNs, pairs.irUpdateNs,
+            multi.kernelNs, multi.irUpdateNs,
+            multi.kernelNs / std::max(1.0e-9, stereoKernel));
+    }
+
+    // 152 taps, the widest the side path runs at stride 2.
+    constexpr std::size_t kTaps = 152;
+    constexpr int kCalls = 200000;
+    std::printf("\nchannel tap kernel, %zu taps; ns/call\n\n%-7s", kTaps, "lanes");
+    const verbsuite::TapKernel kernels[] = { verbsuite::TapKernel::Scalar, verbsuite::TapKernel::SSE2, verbsuite::TapKernel::AVX2, verbsuite::TapKernel::NEON };
+    for (const auto kernel : kernels) {
+        if (verbsuite::tapKernelSupported(kernel)) {
+            std::printf(" %9s", verbsuite::tapKernelName(kernel));
+        }
+    }
+    std::printf("\n");
+    verbsuite::RandomStream random(1);
+    for (std::size_t lanes = 4; lanes <= verbsuite::ChannelStridedTaps::kMaxLanes; lanes += 4) {
+        std::vector<float> history(2 * kTaps * lanes);
+        std::vector<float> ir(kTaps * lanes);
+        random.fill(history.data(), history.size());
+        random.fill(ir.data(), ir.size());
+        verbsuite::ChannelStridedTaps taps;
+        taps.history = history.data() + (2 * kTaps - 1) * lanes;
+        taps.packedIR = ir.data();
+        taps.lanes = lanes;
+        taps.stride = 2;
+        taps.count = kTaps;
+        std::printf("%-7zu", lanes);
+        for (const auto kernel : kernels) {
+            if (!verbsuite::tapKernelSupported(kernel)) {
+                continue;
+            }
+            float wet[verbsuite::ChannelStridedTaps::kMaxLanes] {};
+            float sink = 0.0f;
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < kCalls; ++i) {
+                verbsuite::channelTapSum(taps, wet, kernel);
+                sink += wet[i % lanes];
+            }
+            const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kCalls;
+            std::printf(" %9.1f", ns + (sink == 12345.0f ? 1.0 : 0.0));
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string(argv[1]) == "--profile") {
+        return runProfile(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--pool") {
+        return runPool(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--memory") {
+        return runMemory(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--control") {
+        return runControl(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--channels") {
+        return runChannels(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]).rfind("--", 0) == 0) {
+        return runMatrix(argc, argv);
+    }
+    double seconds = 4.0;
+    if (argc > 1) {
+        seconds = std::max(0.5, std::stod(argv[1]));
+    }
+
+    std::printf("%-18s %14s %14s %10s\n", "tap kernel", "3x ns/sample", "fused ns/smp", "bit-exact");
+    for (const auto kernel : { verbsuite::TapKernel::Scalar, verbsuite::TapKernel::SSE2, verbsuite::TapKernel::AVX2, verbsuite::TapKernel::NEON }) {
+        if (!verbsuite::tapKernelSupported(kernel)) {
+            continue;
+        }
+        const auto stats = timeTapKernel(kernel, seconds);
+        std::printf("%-18s %11.1f ns %11.1f ns %10s\n", verbsuite::tapKernelName(kernel), stats.nsPerSample, stats.fusedNsPerSample, stats.bitExact ? "yes" : "NO");
+    }
+    std::printf("\n");
+
+    std::printf("%-18s %12s %12s %14s %14s   (fast math %s in verb_dsp)\n", "approximation", "max error", "spur dB", "libm ns/call", "fast ns/call", VERBSUITE_FAST_MATH ? "on" : "off");
+    const auto tanhStats = measureApprox([](float x) { return std::tanh(x); }, [](float x) { return verbsuite::fastTanh(x); }, -12.0f, 12.0f, 3.0f, seconds);
+    const auto sinStats = measureApprox([](float x) { return std::sin(x); }, [](float x) { return verbsuite::fastSin(x); }, -20.0f, 20.0f, 16.0f, seconds);
+    std::printf("%-18s %12.2e %12.1f %11.2f ns %11.2f ns\n", "tanh", tanhStats.maxError, tanhStats.spurDb, tanhStats.libmNs, tanhStats.fastNs);
+    std::printf("%-18s %12.2e %12.1f %11.2f ns %11.2f ns\n", "sin", sinStats.maxError, sinStats.spurDb, sinStats.libmNs, sinStats.fastNs);
+    std::printf("\n");
+
+    const auto random = timeRandom(seconds);
+    std::printf("%-18s %14s %14s %14s\n", "rng", "mt19937+dist", "stream", "stream fill");
+    std::printf("%-18s %11.2f ns %11.2f ns %11.2f ns\n", "per draw", random.mt19937Ns, random.streamNs, random.fillNs);
+    std::printf("\n");
+
+    std::printf("%-18s %14s %14s %10s\n", "cv follower", "legacy ns/smp", "ns/sample", "bit-exact");
+    for (const auto shape : { verbsuite::CVShape::Raw, verbsuite::CVShape::Envelope }) {
+        const auto cv = timeCVFollower(shape, seconds);
+        std::printf("%-18s %11.2f ns %11.2f ns %10s\n", shape == verbsuite::CVShape::Raw ? "raw" : "envelope", cv.legacyNs, cv.followerNs, cv.bitExact ? "yes" : "NO");
+    }
+    std::printf("\n");
+
+    const double fileSeconds = seconds * 60.0;
+    const auto files = timeAudioFiles(fileSeconds);
+    std::printf("%-18s %10s %10s %10s %10s %10s %10s %10s   (x realtime, %.0f s stereo)\n", "wav file", "legacy16", "int16", "int24", "int32", "float32", "read", "read mmap", fileSeconds);
+    std::printf("%-18s %9.0fx %9.0fx %9.0fx %9.0fx %9.0fx %9.0fx %9.0fx\n", "48 kHz", files.legacy, files.writer[0], files.writer[1], files.writer[2], files.writer[3], files.streamRead, files.mappedRead);
+    std::printf("\n");
+
+    std::printf("%-18s %9s %9s %9s %9s %9s %9s %9s %9s   (ns/sample, block 256)\n", "stage", "input", "irUpdate", "bands", "convolve", "texture", "quantize", "output", "kernel");
+    for (int m = 0; m < verbsuite::WeirdConvolutionReverb::modeCount(); ++m) {
+        const auto mode = verbsuite::WeirdConvolutionReverb::modeFromIndex(m);
+        const auto t = timeStages(mode, 256, seconds);
+        const double scale = 1.0e9 / static_cast<double>(std::max<std::uint64_t>(1, t.samples));
+        // Everything but IR synthesis: the per-sample kernel itself.
+        const double kernel = t.input + t.bandSplit + t.convolution + t.texture + t.quantize + t.output;
+        std::printf("%-18s %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n",
+            verbsuite::WeirdConvolutionReverb::modeName(mode).c_str(),
+            t.input * scale,
+            t.irUpdate * scale,
+            t.bandSplit * scale,
+            t.convolution * scale,
+            t.texture * scale,
+            t.quantize * scale,
+            t.output * scale,
+            kernel * scale);
+    }
+    std::printf("\n");
+
+    const std::size_t blockSizes[] = { 32, 64, 256, 1024 };
+    const verbsuite::WeirdMode modes[] = { verbsuite::WeirdMode::LivingSignal, verbsuite::WeirdMode::HabitRoom };
+
+    std::printf("%-18s %6s %14s %14s %14s %14s %14s %14s\n", "mode", "block", "direct mean", "direct worst", "upols mean", "upols worst", "nupols mean", "nupols worst");
+    for (const auto mode : modes) {
+        for (const auto blockSize : blockSizes) {
+            const auto direct = timeEngine(verbsuite::ConvolutionEngine::Direct, mode, blockSize, seconds);
+            const auto upols = timeEngine(verbsuite::ConvolutionEngine::Partitioned, mode, blockSize, seconds);
+            const auto nupols = timeEngine(verbsuite::ConvolutionEngine::NonUniform, mode, blockSize, seconds);
+            std::printf("%-18s %6zu %11.1f us %11.1f us %11.1f us %11.1f us %11.1f us %11.1f us\n",
+                verbsuite::WeirdConvolutionReverb::modeName(mode).c_str(),
+                blockSize,
+                direct.meanUs,
+                direct.worstUs,
+                upols.meanUs,
+                upols.worstUs,
+                nupols.meanUs,
+                nupols.worstUs);
+        }
+    }
+    return 0;
+}
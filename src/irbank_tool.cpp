@@ -0,0 +1,56 @@
+#include "VerbSuite/IRBank.h"
+
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <string>
+
+namespace {
+
+void printUsage() {
+    std::cerr << "usage: verb_irbank write <out.vsirb> [sampleRate=48000]\n"
+              << "       verb_irbank info <bank.vsirb>\n";
+}
+
+void printBank(const verbsuite::IRBank& bank) {
+    const auto& irs = bank.irs();
+    for (std::size_t i = 0; i < irs.size(); ++i) {
+        const char* group = i < verbsuite::IRBank::kCoreCount ? "core" : "wild";
+        std::printf("%2zu %-4s %8zu samples @ %8.0f Hz  %8.1f ms\n",
+            i,
+            group,
+            irs[i].size(),
+            bank.irSampleRate(i),
+            1000.0 * static_cast<double>(irs[i].size()) / bank.irSampleRate(i));
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printUsage();
+        return 2;
+    }
+
+    const std::string command = argv[1];
+    const std::string path = argv[2];
+    try {
+        if (command == "write") {
+            const double sampleRate = argc > 3 ? std::stod(argv[3]) : verbsuite::IRBank::kReferenceRate;
+            const auto bank = verbsuite::IRBank::forSampleRate(sampleRate);
+            bank->save(path);
+            std::cout << "Wrote built-in bank at " << sampleRate << " Hz to " << path << '\n';
+            printBank(*bank);
+        } else if (command == "info") {
+            printBank(*verbsuite::IRBank::load(path));
+        } else {
+            printUsage();
+            return 2;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -1,59 +1,32 @@
+#include "VerbSuite/AudioFile.h"
 #include "VerbSuite/WeirdConvolutionReverb.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
-namespace {
+#if !defined(_WIN32)
+#include <time.h>
+#endif
 
-void writeWavStereo16(const std::string& path, const std::vector<float>& left, const std::vector<float>& right, int sampleRate) {
-    const std::size_t n = std::min(left.size(), right.size());
-    std::ofstream out(path, std::ios::binary);
-    if (!out) {
-        throw std::runtime_error("Failed to open output WAV");
-    }
+namespace {
 
-    const int16_t channels = 2;
-    const int16_t bitsPerSample = 16;
-    const int32_t byteRate = sampleRate * channels * (bitsPerSample / 8);
-    const int16_t blockAlign = channels * (bitsPerSample / 8);
-    const int32_t dataSize = static_cast<int32_t>(n * channels * (bitsPerSample / 8));
-    const int32_t chunkSize = 36 + dataSize;
-
-    out.write("RIFF", 4);
-    out.write(reinterpret_cast<const char*>(&chunkSize), 4);
-    out.write("WAVE", 4);
-
-    out.write("fmt ", 4);
-    const int32_t subchunk1Size = 16;
-    const int16_t audioFormat = 1;
-    out.write(reinterpret_cast<const char*>(&subchunk1Size), 4);
-    out.write(reinterpret_cast<const char*>(&audioFormat), 2);
-    out.write(reinterpret_cast<const char*>(&channels), 2);
-    out.write(reinterpret_cast<const char*>(&sampleRate), 4);
-    out.write(reinterpret_cast<const char*>(&byteRate), 4);
-    out.write(reinterpret_cast<const char*>(&blockAlign), 2);
-    out.write(reinterpret_cast<const char*>(&bitsPerSample), 2);
-
-    out.write("data", 4);
-    out.write(reinterpret_cast<const char*>(&dataSize), 4);
-
-    for (std::size_t i = 0; i < n; ++i) {
-        const float cl = std::clamp(left[i], -1.0f, 1.0f);
-        const float cr = std::clamp(right[i], -1.0f, 1.0f);
-        const int16_t li = static_cast<int16_t>(cl * 32767.0f);
-        const int16_t ri = static_cast<int16_t>(cr * 32767.0f);
-        out.write(reinterpret_cast<const char*>(&li), 2);
-        out.write(reinterpret_cast<const char*>(&ri), 2);
-    }
-}
+// Frames moved through the reader, engine and writer per step; the only audio
+// a job ever holds in memory.
+constexpr std::size_t kChunkFrames = 8192;
 
-verbsuite::WeirdMode parseMode(const std::string& value) {
+std::optional<verbsuite::WeirdMode> parseMode(const std::string& value) {
     using verbsuite::WeirdMode;
     if (value == "living") return WeirdMode::LivingSignal;
     if (value == "causal") return WeirdMode::UncannyCausality;
@@ -64,23 +37,19 @@ verbsuite::WeirdMode parseMode(const std::string& value) {
     if (value == "antispace") return WeirdMode::AntiSpace;
     if (value == "afterimage") return WeirdMode::Afterimage;
     if (value == "habit") return WeirdMode::HabitRoom;
-    return WeirdMode::LivingSignal;
+    return std::nullopt;
 }
 
-} // namespace
-
-int main(int argc, char** argv) {
-    constexpr int sampleRate = 48000;
-    constexpr std::size_t totalSamples = sampleRate * 8;
-    constexpr std::size_t blockSize = 64;
-
-    std::string modeArg = "living";
-    if (argc > 1) {
-        modeArg = argv[1];
-    }
-
-    verbsuite::WeirdConvolutionReverb reverb(sampleRate, blockSize, parseMode(modeArg));
+std::optional<verbsuite::SampleFormat> parseFormat(const std::string& value) {
+    using verbsuite::SampleFormat;
+    if (value == "int16") return SampleFormat::Int16;
+    if (value == "int24") return SampleFormat::Int24;
+    if (value == "int32") return SampleFormat::Int32;
+    if (value == "float") return SampleFormat::Float32;
+    return std::nullopt;
+}
 
+verbsuite::WeirdControls demoControls() {
     verbsuite::WeirdControls controls;
     controls.memory = 0.85f;
     controls.coherence = 0.35f;
@@ -89,7 +58,336 @@ int main(int argc, char** argv) {
     controls.stability = 0.22f;
     controls.wet = 0.80f;
     controls.dry = 0.35f;
-    reverb.setControls(controls);
+    return controls;
+}
+
+bool parseBool(const std::string& value) {
+    if (value == "1" || value == "true" || value == "on") return true;
+    if (value == "0" || value == "false" || value == "off") return false;
+    throw std::invalid_argument("expected on/off, got '" + value + "'");
+}
+
+// One automation change, `seconds` into the render.
+struct AutomationPoint {
+    double seconds = 0.0;
+    verbsuite::ControlEvent event;
+};
+
+// Manifest control keys, plus mode, as event targets.
+std::optional<verbsuite::ControlTarget> parseControlTarget(const std::string& key) {
+    using verbsuite::ControlTarget;
+    if (key == "mode") return ControlTarget::Mode;
+    if (key == "memory") return ControlTarget::Memory;
+    if (key == "coherence") return ControlTarget::Coherence;
+    if (key == "entropy") return ControlTarget::Entropy;
+    if (key == "resistance") return ControlTarget::Resistance;
+    if (key == "stability") return ControlTarget::Stability;
+    if (key == "breath_rate") return ControlTarget::BreathRateHz;
+    if (key == "breath_depth") return ControlTarget::BreathDepth;
+    if (key == "breath_beats") return ControlTarget::BreathBeats;
+    if (key == "bpm") return ControlTarget::Bpm;
+    if (key == "tempo_sync") return ControlTarget::TempoSync;
+    if (key == "wild") return ControlTarget::WildIrBank;
+    if (key == "freeze") return ControlTarget::Freeze;
+    if (key == "wet") return ControlTarget::Wet;
+    if (key == "dry") return ControlTarget::Dry;
+    return std::nullopt;
+}
+
+// An automation file holds `<seconds> key=value ...` lines, with the same
+// control keys as the manifest plus mode; `#` starts a comment. Points are
+// returned in time order, ties in file order.
+std::vector<AutomationPoint> parseAutomation(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Failed to open automation file: " + path);
+    }
+
+    std::vector<AutomationPoint> points;
+    std::string text;
+    std::size_t lineNumber = 0;
+    while (std::getline(in, text)) {
+        ++lineNumber;
+        text = text.substr(0, text.find('#'));
+        std::istringstream tokens(text);
+        std::string token;
+        if (!(tokens >> token)) {
+            continue;
+        }
+        try {
+            AutomationPoint point;
+            point.seconds = std::max(0.0, std::stod(token));
+            bool any = false;
+            while (tokens >> token) {
+                const auto eq = token.find('=');
+                if (eq == std::string::npos) {
+                    throw std::invalid_argument("expected key=value, got '" + token + "'");
+                }
+                const std::string key = token.substr(0, eq);
+                const std::string value = token.substr(eq + 1);
+                const auto target = parseControlTarget(key);
+                if (!target) {
+                    throw std::invalid_argument("unknown key '" + key + "'");
+                }
+                point.event.target = *target;
+                using verbsuite::ControlTarget;
+                if (*target == ControlTarget::Mode) {
+                    const auto mode = parseMode(value);
+                    if (!mode) throw std::invalid_argument("unknown mode '" + value + "'");
+                    point.event.value = static_cast<float>(static_cast<int>(*mode));
+                } else if (*target == ControlTarget::TempoSync || *target == ControlTarget::WildIrBank || *target == ControlTarget::Freeze) {
+                    point.event.value = parseBool(value) ? 1.0f : 0.0f;
+                } else {
+                    point.event.value = std::stof(value);
+                }
+                points.push_back(point);
+                any = true;
+            }
+            if (!any) {
+                throw std::invalid_argument("no changes at " + std::to_string(point.seconds) + " s");
+            }
+        } catch (const std::exception& e) {
+            throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+    std::stable_sort(points.begin(), points.end(), [](const AutomationPoint& a, const AutomationPoint& b) {
+        return a.seconds < b.seconds;
+    });
+    return points;
+}
+
+// One manifest line: `in=<wav> out=<wav> [mode=..] [seed=..] [stream=..]
+// [tail=<seconds>] [format=..] [automation=<file>] [control=value ...]`.
+struct RenderJob {
+    std::size_t line = 0;
+    std::string input;
+    std::string output;
+    verbsuite::WeirdMode mode = verbsuite::WeirdMode::LivingSignal;
+    verbsuite::WeirdControls controls = demoControls();
+    std::optional<std::uint64_t> seed;
+    std::uint32_t stream = 0;
+    double tailSeconds = 0.0;
+    verbsuite::SampleFormat format = verbsuite::SampleFormat::Float32;
+    std::vector<AutomationPoint> automation;
+};
+
+std::vector<RenderJob> parseManifest(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Failed to open manifest: " + path);
+    }
+
+    std::vector<RenderJob> jobs;
+    std::string text;
+    std::size_t lineNumber = 0;
+    while (std::getline(in, text)) {
+        ++lineNumber;
+        text = text.substr(0, text.find('#'));
+        std::istringstream tokens(text);
+        std::string token;
+        RenderJob job;
+        job.line = lineNumber;
+        bool any = false;
+        while (tokens >> token) {
+            any = true;
+            const auto eq = token.find('=');
+            if (eq == std::string::npos) {
+                throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": expected key=value, got '" + token + "'");
+            }
+            const std::string key = token.substr(0, eq);
+            const std::string value = token.substr(eq + 1);
+            auto& c = job.controls;
+            try {
+                if (key == "in") job.input = value;
+                else if (key == "out") job.output = value;
+                else if (key == "mode") {
+                    const auto mode = parseMode(value);
+                    if (!mode) throw std::invalid_argument("unknown mode '" + value + "'");
+                    job.mode = *mode;
+                }
+                else if (key == "seed") job.seed = std::stoull(value, nullptr, 0);
+                else if (key == "stream") job.stream = static_cast<std::uint32_t>(std::stoul(value));
+                else if (key == "tail") job.tailSeconds = std::max(0.0, std::stod(value));
+                else if (key == "format") {
+                    const auto format = parseFormat(value);
+                    if (!format) throw std::invalid_argument("unknown format '" + value + "'");
+                    job.format = *format;
+                }
+                else if (key == "automation") job.automation = parseAutomation(value);
+                else if (key == "memory") c.memory = std::stof(value);
+                else if (key == "coherence") c.coherence = std::stof(value);
+                else if (key == "entropy") c.entropy = std::stof(value);
+                else if (key == "resistance") c.resistance = std::stof(value);
+                else if (key == "stability") c.stability = std::stof(value);
+                else if (key == "breath_rate") c.breathRateHz = std::stof(value);
+                else if (key == "breath_depth") c.breathDepth = std::stof(value);
+                else if (key == "breath_beats") c.breathBeats = std::stof(value);
+                else if (key == "bpm") c.bpm = std::stof(value);
+                else if (key == "tempo_sync") c.tempoSync = parseBool(value);
+                else if (key == "wild") c.wildIrBank = parseBool(value);
+                else if (key == "freeze") c.freeze = parseBool(value);
+                else if (key == "wet") c.wet = std::stof(value);
+                else if (key == "dry") c.dry = std::stof(value);
+                else throw std::invalid_argument("unknown key '" + key + "'");
+            } catch (const std::exception& e) {
+                throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": " + e.what());
+            }
+        }
+        if (!any) {
+            continue;
+        }
+        if (job.input.empty() || job.output.empty()) {
+            throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": job needs in= and out=");
+        }
+        jobs.push_back(std::move(job));
+    }
+    return jobs;
+}
+
+struct RenderStats {
+    double audioSeconds = 0.0;
+    double wallSeconds = 0.0;
+    double cpuSeconds = 0.0;
+};
+
+// CPU time of the calling thread, so per-core throughput stays honest when
+// there are more workers than cores. Falls back to wall time.
+double threadCpuSeconds() {
+#if !defined(_WIN32)
+    timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1.0e-9;
+#else
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+RenderStats renderJob(const RenderJob& job, std::size_t blockSize, verbsuite::AudioFileReader::Access access) {
+    const auto start = std::chrono::steady_clock::now();
+    const double cpuStart = threadCpuSeconds();
+    verbsuite::AudioFileReader reader(job.input, access);
+    if (reader.channels() > 2) {
+        throw std::runtime_error("Mono or stereo input only: " + job.input);
+    }
+    const int sampleRate = reader.sampleRate();
+
+    verbsuite::WeirdConvolutionReverb reverb(sampleRate, blockSize, job.mode);
+    reverb.setControls(job.controls);
+    if (job.seed) {
+        reverb.setRandomSeed(*job.seed, job.stream);
+    } else if (job.stream != 0) {
+        reverb.setRandomSeed(reverb.randomSeed(), job.stream);
+    }
+
+    verbsuite::AudioFileWriter writer(job.output, sampleRate, 2, job.format);
+    std::vector<float> left(kChunkFrames);
+    std::vector<float> right(kChunkFrames);
+    float* const channels[] = { left.data(), right.data() };
+    std::uint64_t frames = 0;
+    std::size_t nextPoint = 0;
+    auto tailFrames = static_cast<std::uint64_t>(std::llround(job.tailSeconds * sampleRate));
+    for (;;) {
+        std::size_t n = reader.read(channels, kChunkFrames);
+        if (n > 0 && reader.channels() == 1) {
+            std::copy_n(left.begin(), n, right.begin());
+        } else if (n == 0) {
+            n = static_cast<std::size_t>(std::min<std::uint64_t>(kChunkFrames, tailFrames));
+            if (n == 0) {
+                break;
+            }
+            std::fill_n(left.begin(), n, 0.0f);
+            std::fill_n(right.begin(), n, 0.0f);
+            tailFrames -= n;
+        }
+        for (std::size_t base = 0; base < n;) {
+            std::size_t count = std::min(blockSize, n - base);
+            // Automation lands on its sample inside the block; when the queue
+            // fills, the block ends at the first point that did not fit.
+            const std::uint64_t blockStart = frames + base;
+            while (nextPoint < job.automation.size()) {
+                const auto& point = job.automation[nextPoint];
+                const auto at = static_cast<std::uint64_t>(std::llround(point.seconds * sampleRate));
+                if (at >= blockStart + count) {
+                    break;
+                }
+                auto event = point.event;
+                event.offset = static_cast<std::uint32_t>(at > blockStart ? at - blockStart : 0);
+                if (!reverb.queueControlEvent(event)) {
+                    count = event.offset;
+                    break;
+                }
+                ++nextPoint;
+            }
+            reverb.processBlock(left.data() + base, right.data() + base, count);
+            base += count;
+        }
+        writer.write(channels, n);
+        frames += n;
+    }
+    writer.close();
+
+    RenderStats stats;
+    stats.audioSeconds = static_cast<double>(frames) / sampleRate;
+    stats.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.cpuSeconds = threadCpuSeconds() - cpuStart;
+    return stats;
+}
+
+// Renders every job on `threads` workers, one engine per job. Returns the
+// number of failed jobs.
+int renderManifest(const std::vector<RenderJob>& jobs, std::size_t threads, std::size_t blockSize, verbsuite::AudioFileReader::Access access) {
+    std::atomic<std::size_t> next { 0 };
+    std::mutex reportMutex;
+    std::vector<RenderStats> stats(jobs.size());
+    std::vector<bool> failed(jobs.size(), false);
+
+    const auto worker = [&] {
+        for (std::size_t i = next.fetch_add(1); i < jobs.size(); i = next.fetch_add(1)) {
+            try {
+                stats[i] = renderJob(jobs[i], blockSize, access);
+                const std::lock_guard<std::mutex> lock(reportMutex);
+                std::cout << jobs[i].output << ": " << stats[i].audioSeconds << " s in " << stats[i].wallSeconds << " s ("
+                          << stats[i].audioSeconds / std::max(1.0e-9, stats[i].cpuSeconds) << "x realtime per core)\n";
+            } catch (const std::exception& e) {
+                const std::lock_guard<std::mutex> lock(reportMutex);
+                failed[i] = true;
+                std::cerr << "line " << jobs[i].line << " (" << jobs[i].input << "): " << e.what() << '\n';
+            }
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    threads = std::max<std::size_t>(1, std::min(threads, jobs.size()));
+    for (std::size_t t = 0; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double audio = 0.0;
+    double cpu = 0.0;
+    for (const auto& s : stats) {
+        audio += s.audioSeconds;
+        cpu += s.cpuSeconds;
+    }
+    const auto failures = static_cast<int>(std::count(failed.begin(), failed.end(), true));
+    std::cout << "Rendered " << jobs.size() - static_cast<std::size_t>(failures) << "/" << jobs.size() << " jobs, " << audio << " s of audio in " << wall
+              << " s on " << threads << " threads: " << audio / std::max(1.0e-9, wall) << "x realtime total, "
+              << audio / std::max(1.0e-9, cpu) << "x realtime per core\n";
+    return failures;
+}
+
+// The original single-mode demo: a synthetic test signal through one mode.
+void renderDemo(verbsuite::WeirdMode mode, const std::string& outputPath) {
+    constexpr int sampleRate = 48000;
+    constexpr std::size_t totalSamples = sampleRate * 8;
+    constexpr std::size_t blockSize = 64;
+
+    verbsuite::WeirdConvolutionReverb reverb(sampleRate, blockSize, mode);
+    reverb.setControls(demoControls());
 
     std::vector<float> left(totalSamples, 0.0f);
     std::vector<float> right(totalSamples, 0.0f);
@@ -117,9 +415,63 @@ int main(int argc, char** argv) {
         reverb.processBlock(left.data() + base, right.data() + base, n);
     }
 
-    const std::string outputPath = "weird_" + modeArg + ".wav";
-    writeWavStereo16(outputPath, left, right, sampleRate);
+    verbsuite::AudioFileWriter writer(outputPath, sampleRate, 2, verbsuite::SampleFormat::Int16);
+    const float* const channels[] = { left.data(), right.data() };
+    writer.write(channels, totalSamples);
+    writer.close();
+}
+
+void printUsage() {
+    std::cerr << "usage: verb_suite_demo [mode]\n"
+              << "       verb_suite_demo render <manifest> [--threads N] [--block N] [--mmap]\n"
+              << "modes: living causal spectral memory imprint digital antispace afterimage habit\n"
+              << "manifest: one job per line, e.g.\n"
+              << "  in=dry.wav out=wet.wav mode=habit seed=7 tail=4 format=int24 wild=on entropy=0.8\n"
+              << "formats: int16 int24 int32 float (default)\n"
+              << "automation=<file>: `<seconds> key=value ...` lines, e.g. `2.5 stability=0.9 mode=digital`\n";
+}
 
-    std::cout << "Rendered mode=" << modeArg << " to " << outputPath << '\n';
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        if (argc > 1 && std::string(argv[1]) == "render") {
+            if (argc < 3) {
+                printUsage();
+                return 2;
+            }
+            std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+            std::size_t blockSize = 512;
+            auto access = verbsuite::AudioFileReader::Access::Stream;
+            for (int i = 3; i < argc; ++i) {
+                const std::string flag = argv[i];
+                if (flag == "--threads" && i + 1 < argc) {
+                    threads = std::max<std::size_t>(1, std::stoul(argv[++i]));
+                } else if (flag == "--block" && i + 1 < argc) {
+                    blockSize = std::max<std::size_t>(1, std::stoul(argv[++i]));
+                } else if (flag == "--mmap") {
+                    access = verbsuite::AudioFileReader::Access::MemoryMap;
+                } else {
+                    printUsage();
+                    return 2;
+                }
+            }
+            const auto jobs = parseManifest(argv[2]);
+            return renderManifest(jobs, threads, blockSize, access) == 0 ? 0 : 1;
+        }
+
+        const std::string modeArg = argc > 1 ? argv[1] : "living";
+        const auto mode = parseMode(modeArg);
+        if (!mode) {
+            printUsage();
+            return 2;
+        }
+        const std::string outputPath = "weird_" + modeArg + ".wav";
+        renderDemo(*mode, outputPath);
+        std::cout << "Rendered mode=" << modeArg << " to " << outputPath << '\n';
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
     return 0;
 }